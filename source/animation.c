@@ -1,80 +1,83 @@
-#include <stdlib.h>
+#include <stddef.h>
 
 #include "animation.h"
 
+static Animation animationBank[ANIMATIONBANK_MAX];
+static u32 animationBankLen;
 
-Animation
-*Animation_Create(u32 frames[], u32 framesLen, u32 fps, u8 loop)
+void
+AnimationBank_Clear(void)
 {
-	Animation *Return = calloc(1, sizeof(Animation) + sizeof(u32) * framesLen);
-    if(!Return) return NULL;
-
-	Return->timer = 0;
-	Return->framesLen = framesLen;
-	Return->curFrame = 0;
-	Return->ticksPerFrame = 60 / fps;
-	Return->state = ANIMSTATE_STOPPED;
-	Return->loop = loop;
-
-    for(size_t i = 0; i < framesLen; i++)
-    {
-        Return->frames[i] = frames[i];
-    }
-
-	return Return;
+    animationBankLen = 0;
 }
 
-void
-Animation_Destroy(Animation *anim)
+Animation
+*AnimationBank_Add(const AnimationDef *def)
 {
-    free(anim);
+    ASSERT(animationBankLen < ANIMATIONBANK_MAX);
+    if(animationBankLen == ANIMATIONBANK_MAX) return NULL;
+
+    Animation *anim = &animationBank[animationBankLen++];
+    anim->def = def;
+    anim->curFrame = 0;
+    anim->countdown = def->durations[0];
+    anim->playing = FALSE;
+
+    return anim;
 }
 
-void
-Animation_Update(Animation *anim, u32 ticks)
+// the frame changes when its countdown runs out. a stopping animation
+// stays on its last frame
+IWRAM_CODE void
+AnimationBank_UpdateAll(void)
 {
-    if(anim->state == ANIMSTATE_STOPPED) return;
-
-    anim->timer += ticks;
-    
-    anim->curFrame = anim->timer / anim->ticksPerFrame;
-    if(anim->curFrame >= anim->framesLen)
+    for(u32 i = 0; i < animationBankLen; i++)
     {
-        if(anim->loop)
-        {
-            anim->curFrame = anim->curFrame % anim->framesLen;
-        }
-        else
+        Animation *anim = &animationBank[i];
+        if(!anim->playing) continue;
+        if(--anim->countdown) continue;
+
+        const AnimationDef *def = anim->def;
+        u32 next = anim->curFrame + 1;
+        if(next == def->framesLen)
         {
-            anim->curFrame = anim->framesLen - 1;
-            anim->state = ANIMSTATE_STOPPED;
+            if(!def->loop)
+            {
+                // played again without a restart it stops straight away
+                anim->countdown = 1;
+                anim->playing = FALSE;
+                continue;
+            }
+            next = 0;
         }
+        anim->curFrame = next;
+        anim->countdown = def->durations[next];
     }
 }
 
 void
 Animation_Play(Animation *anim)
 {
-    anim->state = ANIMSTATE_PLAYING;
+    anim->playing = TRUE;
 }
 
 void
 Animation_Pause(Animation *anim)
 {
-    anim->state = ANIMSTATE_STOPPED;
+    anim->playing = FALSE;
 }
 
 void
 Animation_Restart(Animation *anim)
 {
-    anim->timer = 0;
-    anim->curFrame = 0;
-    anim->state = ANIMSTATE_PLAYING;
+    Animation_SetFrame(anim, 0);
+    anim->playing = TRUE;
 }
 
 void
 Animation_SetFrame(Animation *anim, u32 frameIndex)
 {
-    anim->curFrame = anim->frames[frameIndex];
-    anim->timer = anim->curFrame * anim->ticksPerFrame;
+    ASSERT(frameIndex < anim->def->framesLen);
+    anim->curFrame = frameIndex;
+    anim->countdown = anim->def->durations[frameIndex];
 }
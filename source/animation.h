@@ -3,30 +3,46 @@
 
 #include "gba.h"
 
-typedef enum AnimState
+// An animation is a const table in ROM: the attr2 char name of each
+// frame and how many updates it stays up for. What plays it is a few
+// bytes out of the bank below, so nothing is allocated or copied when a
+// scene is set up and nothing is left behind when it's torn down
+typedef struct AnimationDef
 {
-    ANIMSTATE_STOPPED,
-    ANIMSTATE_PLAYING
-} AnimState;
+    const u16 *frames;
+    const u8 *durations;
+    u8 framesLen;
+	// loop: bool, 0-stop on the last frame, 1-loop
+    u8 loop;
+} AnimationDef;
 
 typedef struct Animation
 {
-    u32 timer;
-    u32 curFrame;
-    u32 ticksPerFrame;
-    AnimState state;
-	// loop: bool, 0-don't loop, 1-loop
-    u8 loop;
-    u32 framesLen;
-    u32 frames[];
+    const AnimationDef *def;
+    u8 curFrame;
+    u8 countdown; // updates left on curFrame
+    u8 playing;
 } Animation;
 
-Animation *Animation_Create(u32 *frames, u32 framesLen, u32 fps, u8 loop);
-void Animation_Destroy(Animation *anim);
-void Animation_Update(Animation *anim, u32 ticks);
+// All the animations of a scene. AnimationBank_UpdateAll moves every one
+// that's playing on by an update, counting down instead of dividing a
+// timer, so each one costs a compare and a decrement most frames
+#define ANIMATIONBANK_MAX 8
+
+void AnimationBank_Clear(void);
+// a stopped instance of `def` on its first frame, NULL once the bank is full
+Animation *AnimationBank_Add(const AnimationDef *def);
+IWRAM_CODE void AnimationBank_UpdateAll(void);
+
 void Animation_Play(Animation *anim);
 void Animation_Pause(Animation *anim);
 void Animation_Restart(Animation *anim);
 void Animation_SetFrame(Animation *anim, u32 frameIndex);
 
+// char name of the frame showing
+static inline u32 Animation_CharName(const Animation *anim)
+{
+    return anim->def->frames[anim->curFrame];
+}
+
 #endif
@@ -15,14 +15,14 @@ Rectangle_Create(u32 x, u32 y, u32 w, u32 h)
     return Return;
 }
 
-u32
-CheckCollision_RectRect(Rectangle a, Rectangle b)
+IWRAM_CODE u32
+CheckCollision_RectRect(const Rectangle *a, const Rectangle *b)
 {
     u32 collisionX = 0;
     u32 collisionY = 0;
 
-    collisionX = (a.x + a.w >= b.x) && (b.x + b.w >= a.x);
-    collisionY = (a.y + a.h >= b.y) && (b.y + b.h >= a.y);
+    collisionX = (a->x + a->w >= b->x) && (b->x + b->w >= a->x);
+    collisionY = (a->y + a->h >= b->y) && (b->y + b->h >= a->y);
 
 #if 0
     char debug_msg[DEBUG_MSG_LEN];
@@ -32,3 +32,176 @@ CheckCollision_RectRect(Rectangle a, Rectangle b)
 
     return collisionX && collisionY;
 }
+
+// first row of the mask at screen line y, and the step to the next one
+static inline const u32 *
+CollisionMask_Row(const CollisionMask *mask, i32 y, i32 *step)
+{
+    if(mask->flipV)
+    {
+        *step = -1;
+        return mask->rows + mask->h - 1 - (y - mask->y);
+    }
+    *step = 1;
+    return mask->rows + (y - mask->y);
+}
+
+IWRAM_CODE u32
+CheckCollision_MaskMask(const CollisionMask *a, const CollisionMask *b)
+{
+    i32 dx = b->x - a->x;
+    if(dx >= 32 || dx <= -32) return 0;
+
+    i32 top = (a->y > b->y) ? a->y : b->y;
+    i32 aBtm = a->y + (i32)a->h;
+    i32 bBtm = b->y + (i32)b->h;
+    i32 btm = (aBtm < bBtm) ? aBtm : bBtm;
+    if(top >= btm) return 0;
+
+    // line both rows up on the left one's pixels
+    u32 shiftA = (dx < 0) ? -dx : 0;
+    u32 shiftB = (dx > 0) ? dx : 0;
+
+    i32 stepA, stepB;
+    const u32 *rowA = CollisionMask_Row(a, top, &stepA);
+    const u32 *rowB = CollisionMask_Row(b, top, &stepB);
+    for(i32 y = top; y < btm; y++, rowA += stepA, rowB += stepB)
+    {
+        if((*rowA >> shiftA) & (*rowB >> shiftB)) return 1;
+    }
+
+    return 0;
+}
+
+#define COLLIDERSET_SLOT(set, i) (((set)->head + (i)) & (COLLIDERSET_MAX - 1))
+
+void
+ColliderSet_Clear(ColliderSet *set)
+{
+    set->head = 0;
+    set->count = 0;
+    set->scroll = 0;
+    set->maxWidth = 0;
+}
+
+// boxes mostly come in from the right, so the insertion sort stops
+// straight away
+u32
+ColliderSet_Add(ColliderSet *set, const Rectangle *box, u32 id)
+{
+    ASSERT(set->count < COLLIDERSET_MAX);
+    if(set->count == COLLIDERSET_MAX) return 0;
+
+    i32 x0 = box->x + set->scroll;
+    u32 i = set->count++;
+    for(; i > 0; i--)
+    {
+        u32 prev = COLLIDERSET_SLOT(set, i - 1);
+        if(PackedBox_Min(set->x[prev]) <= x0) break;
+
+        u32 cur = COLLIDERSET_SLOT(set, i);
+        set->x[cur] = set->x[prev];
+        set->y[cur] = set->y[prev];
+        set->id[cur] = set->id[prev];
+    }
+
+    u32 slot = COLLIDERSET_SLOT(set, i);
+    set->x[slot] = PackedBox_Span(x0, x0 + box->w);
+    set->y[slot] = PackedBox_Span(box->y, box->y + box->h);
+    set->id[slot] = id;
+    if(box->w > set->maxWidth) set->maxWidth = box->w;
+
+    return 1;
+}
+
+void
+ColliderSet_Scroll(ColliderSet *set, i32 dx)
+{
+    set->scroll += dx;
+    if(set->scroll < COLLIDERSET_REBASE) return;
+
+    // pull world x back towards 0
+    for(u32 i = 0; i < set->count; i++)
+    {
+        u32 slot = COLLIDERSET_SLOT(set, i);
+        set->x[slot] = PackedBox_Move(set->x[slot], -set->scroll);
+    }
+    set->scroll = 0;
+}
+
+void
+ColliderSet_Cull(ColliderSet *set, i32 minX)
+{
+    i32 worldMinX = minX + set->scroll;
+    while(set->count && PackedBox_Max(set->x[set->head]) < worldMinX)
+    {
+        set->head = (set->head + 1) & (COLLIDERSET_MAX - 1);
+        set->count--;
+    }
+}
+
+// first box (in ring order) that starts far enough right to reach x
+static inline u32
+ColliderSet_Lower(const ColliderSet *set, i32 x)
+{
+    u32 lo = 0;
+    u32 hi = set->count;
+    while(lo < hi)
+    {
+        u32 mid = (lo + hi) >> 1;
+        if(PackedBox_Min(set->x[COLLIDERSET_SLOT(set, mid)]) < x) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+IWRAM_CODE u32
+ColliderSet_Hit(const ColliderSet *set, const Rectangle *box)
+{
+    u32 hit;
+    return ColliderSet_Query(set, box, &hit, 1) ? hit : COLLIDER_NONE;
+}
+
+IWRAM_CODE u32
+ColliderSet_Query(const ColliderSet *set, const Rectangle *box, u32 *hits, u32 maxHits)
+{
+    i32 qx0 = box->x + set->scroll;
+    i32 qx1 = qx0 + box->w;
+    u32 qx = PackedBox_Rotate(PackedBox_Span(qx0, qx1));
+    u32 qy = PackedBox_Rotate(PackedBox_Span(box->y, box->y + box->h));
+    u32 n = 0;
+
+    // everything before this ends left of the query, everything past the
+    // first box starting right of it can't reach it either
+    for(u32 i = ColliderSet_Lower(set, qx0 - set->maxWidth); i < set->count; i++)
+    {
+        u32 slot = COLLIDERSET_SLOT(set, i);
+        if(PackedBox_Min(set->x[slot]) > qx1) break;
+
+        u32 t = (set->x[slot] + qx) & (set->y[slot] + qy);
+        if(t & (t << 16) & 0x80000000)
+        {
+            hits[n++] = set->id[slot];
+            if(n == maxHits) break;
+        }
+    }
+
+    return n;
+}
+
+// the rotated box is added to every other one, so it's done once
+IWRAM_CODE u32
+PackedBox_OverlapMask(const PackedBox *box, const PackedBox *boxes, u32 count)
+{
+    ASSERT(count <= 32);
+
+    u32 bx = PackedBox_Rotate(box->x);
+    u32 by = PackedBox_Rotate(box->y);
+    u32 mask = 0;
+    for(u32 i = 0; i < count; i++)
+    {
+        u32 t = (boxes[i].x + bx) & (boxes[i].y + by);
+        mask |= ((t & (t << 16)) >> 31) << i;
+    }
+    return mask;
+}
@@ -13,6 +13,110 @@ typedef struct Rectangle {
 
 Rectangle Rectangle_Create(u32 x, u32 y, u32 w, u32 h);
 
-u32 CheckCollision_RectRect(Rectangle a, Rectangle b);
+IWRAM_CODE u32 CheckCollision_RectRect(const Rectangle *a, const Rectangle *b);
+
+// Boxes packed for SWAR tests, one word per axis: the max edge plus
+// PACKEDBOX_BIAS in the top half, PACKEDBOX_BIAS minus the min edge in the
+// bottom half. Adding a box's word to the other's rotated by 16 (free on
+// the ARM's barrel shifter) gives a.max - b.min and b.max - a.min, both
+// offset by 2 * BIAS, in one add without carries between the halves. The
+// boxes overlap on that axis when both halves have bit 15 set, so ANDing
+// the two axes and folding the halves together answers the whole test
+// without a branch. Edges are inclusive like Rectangle's, coordinates
+// have to stay within [-PACKEDBOX_BIAS, PACKEDBOX_BIAS)
+#define PACKEDBOX_BIAS 0x4000
+
+typedef struct PackedBox {
+    u32 x;
+    u32 y;
+} PackedBox;
+
+static inline u32 PackedBox_Span(i32 min, i32 max)
+{
+    return ((u32)(max + PACKEDBOX_BIAS) << 16) | (u32)(PACKEDBOX_BIAS - min);
+}
+
+static inline i32 PackedBox_Min(u32 span) { return PACKEDBOX_BIAS - (i32)(span & 0xFFFF); }
+static inline i32 PackedBox_Max(u32 span) { return (i32)(span >> 16) - PACKEDBOX_BIAS; }
+
+// move a span by dx, both halves in one add
+static inline u32 PackedBox_Move(u32 span, i32 dx)
+{
+    return span + ((u32)dx << 16) - (u32)dx;
+}
+
+static inline PackedBox PackedBox_FromRect(const Rectangle *r)
+{
+    return (PackedBox){ PackedBox_Span(r->x, r->x + r->w), PackedBox_Span(r->y, r->y + r->h) };
+}
+
+static inline u32 PackedBox_Rotate(u32 span)
+{
+    return (span >> 16) | (span << 16);
+}
+
+static inline u32 PackedBox_Overlap(const PackedBox *a, const PackedBox *b)
+{
+    u32 t = (a->x + PackedBox_Rotate(b->x)) & (a->y + PackedBox_Rotate(b->y));
+    return (t & (t << 16)) >> 31;
+}
+
+// bit i set for each of the (up to 32) boxes overlapping `box`
+IWRAM_CODE u32 PackedBox_OverlapMask(const PackedBox *box, const PackedBox *boxes, u32 count);
+
+// Narrowphase on the pixel masks tools/tile-builder writes for each
+// sprite (SPRITE_*_MASK): a word per row, leftmost pixel in bit 31. Two
+// masks are compared with one AND per overlapping row, the row of the
+// one further right shifted across. Only worth running once a box test
+// has hit. flipV walks the rows bottom up, for OBJs with ATTR1_FLIPVERT
+typedef struct CollisionMask {
+    const u32 *rows;
+    i32 x;
+    i32 y;
+    u32 h;
+    u32 flipV;
+} CollisionMask;
+
+IWRAM_CODE u32 CheckCollision_MaskMask(const CollisionMask *a, const CollisionMask *b);
+
+// Broadphase for things that scroll past the player together (obstacles,
+// later hazards and pickups). Boxes are kept in a ring sorted by their
+// left edge, in world space: scrolling the whole set moves the origin
+// instead of every box, and boxes leave from the head once they're off
+// the left side. A query only looks at the boxes whose x-span can reach
+// the one asked about, found with a binary search, so it costs the same
+// with 4 boxes or 30.
+//
+// The boxes are PackedBoxes split into an array per axis, so the search
+// and the cut-off only pull in the x spans. World x is rebased every COLLIDERSET_REBASE pixels of scrolling
+// to stay in the packed range
+
+#define COLLIDERSET_MAX 32 // power of two
+#define COLLIDER_NONE 0xFFFFFFFF
+#define COLLIDERSET_REBASE 0x1000
+
+typedef struct ColliderSet {
+    u32 x[COLLIDERSET_MAX]; // PackedBox spans
+    u32 y[COLLIDERSET_MAX];
+    u32 id[COLLIDERSET_MAX];   // whatever the owner wants back from a hit
+    u32 head;
+    u32 count;
+    i32 scroll;   // world x of screen x 0
+    i32 maxWidth; // widest box added, bounds how far back a query looks
+} ColliderSet;
+
+void ColliderSet_Clear(ColliderSet *set);
+// `box` is in screen space. Returns 0 if the set is full
+u32 ColliderSet_Add(ColliderSet *set, const Rectangle *box, u32 id);
+// move every box left by dx pixels
+void ColliderSet_Scroll(ColliderSet *set, i32 dx);
+// drop the boxes at the front whose right edge is left of screen x `minX`
+void ColliderSet_Cull(ColliderSet *set, i32 minX);
+
+// id of the first box overlapping `box` (screen space), COLLIDER_NONE if
+// there's none
+IWRAM_CODE u32 ColliderSet_Hit(const ColliderSet *set, const Rectangle *box);
+// every box overlapping `box`, up to maxHits ids. Returns the count
+IWRAM_CODE u32 ColliderSet_Query(const ColliderSet *set, const Rectangle *box, u32 *hits, u32 maxHits);
 
 #endif
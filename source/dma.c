@@ -0,0 +1,157 @@
+#include "dma.h"
+
+// source values for fire-and-forget fills. a fixed-source DMA reads its
+// source every unit so the value has to stay put until the transfer ends
+static volatile u32 dmaFillValue[DMA_CHANNEL_COUNT];
+
+#ifdef __HOST__
+volatile DMA_REC DMA_HostRegs[DMA_CHANNEL_COUNT];
+DMA_HostLog DMA_HostLogs[DMA_CHANNEL_COUNT];
+
+// Run the transfer currently programmed into the channel's registers
+static void DMA_HostRun(u32 channel)
+{
+	volatile DMA_REC *rec = &REG_DMA[channel];
+	u32 cnt = rec->cnt;
+	u32 units = cnt & DMACNT_COUNT_MASK;
+	u32 unitSize = (cnt & DMA_32) ? 4 : 2;
+	u32 srcMode = (cnt >> DMACNT_SRCMODE_SHIFT) & 3;
+	u32 dstMode = (cnt >> DMACNT_DSTMODE_SHIFT) & 3;
+
+	// a count of 0 means the maximum transfer length
+	if(units == 0) units = (channel == 3) ? 0x10000 : 0x4000;
+
+	const u8 *src = rec->src;
+	u8 *dst = rec->dst;
+	for(u32 i = 0; i < units; i++)
+	{
+		if(unitSize == 4) *(u32 *)dst = *(const u32 *)src;
+		else              *(u16 *)dst = *(const u16 *)src;
+
+		if(srcMode == DMA_ADDR_INC) src += unitSize;
+		else if(srcMode == DMA_ADDR_DEC) src -= unitSize;
+		if(dstMode == DMA_ADDR_INC || dstMode == DMA_ADDR_RELOAD) dst += unitSize;
+		else if(dstMode == DMA_ADDR_DEC) dst -= unitSize;
+	}
+
+	// the source address register keeps counting between repeats,
+	// the destination only does if it isn't set to reload
+	rec->src = src;
+	if(dstMode != DMA_ADDR_RELOAD) rec->dst = dst;
+
+	DMA_HostLogs[channel].transfers++;
+	DMA_HostLogs[channel].units += units;
+	DMA_HostLogs[channel].bytes += units * unitSize;
+	DMA_HostLogs[channel].lastCnt = cnt;
+
+	if(!(cnt & DMA_REPEAT) || ((cnt >> DMACNT_TIMING_SHIFT) & 3) == DMA_TIMING_NOW)
+	{
+		rec->cnt = cnt & ~DMA_ENABLE;
+	}
+}
+
+void DMA_HostTrigger(u32 timing)
+{
+	for(u32 ch = 0; ch < DMA_CHANNEL_COUNT; ch++)
+	{
+		u32 cnt = REG_DMA[ch].cnt;
+		if((cnt & DMA_ENABLE) && ((cnt >> DMACNT_TIMING_SHIFT) & 3) == timing)
+		{
+			DMA_HostRun(ch);
+		}
+	}
+}
+
+void DMA_HostReset(void)
+{
+	for(u32 ch = 0; ch < DMA_CHANNEL_COUNT; ch++)
+	{
+		REG_DMA[ch].src = 0;
+		REG_DMA[ch].dst = 0;
+		REG_DMA[ch].cnt = 0;
+		DMA_HostLogs[ch] = (DMA_HostLog){0};
+	}
+}
+#endif
+
+// Program a channel and start it. The control word is written last since
+// that's what kicks off the transfer
+static inline void DMA_Set(u32 channel, void *dst, const void *src, u32 count, u32 mode)
+{
+	ASSERT(channel < DMA_CHANNEL_COUNT);
+
+	volatile DMA_REC *rec = &REG_DMA[channel];
+	rec->cnt = 0;
+	rec->src = src;
+	rec->dst = dst;
+	rec->cnt = (count & DMACNT_COUNT_MASK) | mode | DMA_ENABLE;
+
+#ifdef __HOST__
+	if(((mode >> DMACNT_TIMING_SHIFT) & 3) == DMA_TIMING_NOW)
+	{
+		DMA_HostRun(channel);
+	}
+#endif
+}
+
+void DMA_Copy16(u32 channel, void *dst, const void *src, u32 count)
+{
+	DMA_Set(channel, dst, src, count, DMA_COPY16);
+	DMA_Wait(channel);
+}
+
+void DMA_Copy32(u32 channel, void *dst, const void *src, u32 count)
+{
+	DMA_Set(channel, dst, src, count, DMA_COPY32);
+	DMA_Wait(channel);
+}
+
+void DMA_Fill16(u32 channel, void *dst, u16 value, u32 count)
+{
+	// DMA reads the source over the bus, so the value needs an address
+	volatile u32 fill = value | ((u32)value << 16);
+	DMA_Set(channel, dst, (const void *)&fill, count, DMA_FILL16);
+	DMA_Wait(channel);
+}
+
+void DMA_Fill32(u32 channel, void *dst, u32 value, u32 count)
+{
+	volatile u32 fill = value;
+	DMA_Set(channel, dst, (const void *)&fill, count, DMA_FILL32);
+	DMA_Wait(channel);
+}
+
+void DMA_Start(u32 channel, void *dst, const void *src, u32 count, u32 mode)
+{
+	DMA_Set(channel, dst, src, count, mode);
+}
+
+void DMA_StartFill(u32 channel, void *dst, u32 value, u32 count, u32 mode)
+{
+	dmaFillValue[channel] = (mode & DMA_32) ? value : ((value & 0xFFFF) | (value << 16));
+	DMA_Set(
+		channel,
+		dst,
+		(const void *)&dmaFillValue[channel],
+		count,
+		(mode & ~DMA_SRC(DMA_ADDR_RELOAD)) | DMA_SRC(DMA_ADDR_FIXED)
+	);
+}
+
+u32 DMA_Busy(u32 channel)
+{
+	return (REG_DMA[channel].cnt & DMA_ENABLE) ? 1 : 0;
+}
+
+// Immediate transfers halt the CPU until they finish, but the transfer
+// only starts two cycles after the control write. Blank-timed transfers
+// need polling
+void DMA_Wait(u32 channel)
+{
+	while(REG_DMA[channel].cnt & DMA_ENABLE);
+}
+
+void DMA_Stop(u32 channel)
+{
+	REG_DMA[channel].cnt = 0;
+}
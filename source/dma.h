@@ -0,0 +1,108 @@
+#ifndef __DMA_H__
+#define __DMA_H__
+
+#include "gba.h"
+
+// DMA channels
+// 0: highest priority, can't read from ROM. good for HBlank effects
+// 1, 2: sound FIFO channels, general purpose otherwise
+// 3: general purpose, the only channel that can write to the gamepak
+#define DMA_CHANNEL_COUNT 4
+
+// DMA register block, one record per channel starting at 0x040000B0
+// on the host build the block is a plain array so transfers can be
+// inspected without hardware
+typedef struct {
+	const void *src;
+	void *dst;
+	u32 cnt;
+} DMA_REC;
+
+#ifdef __HOST__
+extern volatile DMA_REC DMA_HostRegs[DMA_CHANNEL_COUNT];
+#define REG_DMA DMA_HostRegs
+#else
+#define REG_DMA ((volatile DMA_REC *)0x040000B0)
+#endif
+
+// DMA Control, shift amounts
+// the lower 16 bits of `cnt` are the transfer count (in units), the upper
+// 16 bits are the control register
+#define DMACNT_COUNT_MASK 0xFFFF
+#define DMACNT_DSTMODE_SHIFT 21
+#define DMACNT_SRCMODE_SHIFT 23
+#define DMACNT_REPEAT_SHIFT 25
+#define DMACNT_32BIT_SHIFT 26
+#define DMACNT_TIMING_SHIFT 28
+#define DMACNT_IRQ_SHIFT 30
+#define DMACNT_ENABLE_SHIFT 31
+
+// address control for the source and destination
+#define DMA_ADDR_INC 0
+#define DMA_ADDR_DEC 1
+#define DMA_ADDR_FIXED 2
+#define DMA_ADDR_RELOAD 3 // destination only
+
+// start timing
+#define DMA_TIMING_NOW 0
+#define DMA_TIMING_VBLANK 1
+#define DMA_TIMING_HBLANK 2
+#define DMA_TIMING_SPECIAL 3
+
+#define DMA_DST(mode)    ((u32)(mode) << DMACNT_DSTMODE_SHIFT)
+#define DMA_SRC(mode)    ((u32)(mode) << DMACNT_SRCMODE_SHIFT)
+#define DMA_TIMING(when) ((u32)(when) << DMACNT_TIMING_SHIFT)
+#define DMA_REPEAT       (1u << DMACNT_REPEAT_SHIFT)
+#define DMA_32           (1u << DMACNT_32BIT_SHIFT)
+#define DMA_16           0
+#define DMA_IRQ          (1u << DMACNT_IRQ_SHIFT)
+#define DMA_ENABLE       (1u << DMACNT_ENABLE_SHIFT)
+
+// common modes
+#define DMA_COPY16 (DMA_16 | DMA_SRC(DMA_ADDR_INC)   | DMA_DST(DMA_ADDR_INC))
+#define DMA_COPY32 (DMA_32 | DMA_SRC(DMA_ADDR_INC)   | DMA_DST(DMA_ADDR_INC))
+#define DMA_FILL16 (DMA_16 | DMA_SRC(DMA_ADDR_FIXED) | DMA_DST(DMA_ADDR_INC))
+#define DMA_FILL32 (DMA_32 | DMA_SRC(DMA_ADDR_FIXED) | DMA_DST(DMA_ADDR_INC))
+// repeating blank-triggered copy, destination reset after each transfer
+#define DMA_HBLANK_COPY16 (DMA_16 | DMA_SRC(DMA_ADDR_INC) | DMA_DST(DMA_ADDR_RELOAD) | DMA_REPEAT | DMA_TIMING(DMA_TIMING_HBLANK))
+#define DMA_HBLANK_COPY32 (DMA_32 | DMA_SRC(DMA_ADDR_INC) | DMA_DST(DMA_ADDR_RELOAD) | DMA_REPEAT | DMA_TIMING(DMA_TIMING_HBLANK))
+#define DMA_VBLANK_COPY32 (DMA_32 | DMA_SRC(DMA_ADDR_INC) | DMA_DST(DMA_ADDR_INC) | DMA_TIMING(DMA_TIMING_VBLANK))
+
+// the channel used for general purpose VRAM/palette/OAM uploads
+#define DMA_CHANNEL_GENERAL 3
+
+// Blocking transfers. `count` is the number of units (halfwords for the
+// 16-bit calls, words for the 32-bit calls). These return once the
+// transfer is done
+void DMA_Copy16(u32 channel, void *dst, const void *src, u32 count);
+void DMA_Copy32(u32 channel, void *dst, const void *src, u32 count);
+void DMA_Fill16(u32 channel, void *dst, u16 value, u32 count);
+void DMA_Fill32(u32 channel, void *dst, u32 value, u32 count);
+
+// Fire-and-forget transfers. `mode` is built from the DMA_* flags above;
+// the enable bit is added here. A fill keeps its source value in a
+// per-channel slot so the caller's value doesn't need to outlive the call
+void DMA_Start(u32 channel, void *dst, const void *src, u32 count, u32 mode);
+void DMA_StartFill(u32 channel, void *dst, u32 value, u32 count, u32 mode);
+u32  DMA_Busy(u32 channel);
+void DMA_Wait(u32 channel);
+void DMA_Stop(u32 channel);
+
+#ifdef __HOST__
+// Host-side mock. Immediate transfers run in DMA_Start; blank-timed
+// transfers stay pending until the matching DMA_HostTrigger() call.
+// The log keeps the last transfer started on each channel
+typedef struct {
+	u32 transfers;
+	u32 units;
+	u32 bytes;
+	u32 lastCnt;
+} DMA_HostLog;
+
+extern DMA_HostLog DMA_HostLogs[DMA_CHANNEL_COUNT];
+
+void DMA_HostTrigger(u32 timing);
+void DMA_HostReset(void);
+#endif
+
+#endif
@@ -10,14 +10,209 @@
 typedef i32 fp_t;
 
 #define FP_FRACBITS 16
+#define FP_ONE (1 << FP_FRACBITS)
 
-fp_t Int2FP(i32 i);
-i32  FP2Int(fp_t i);
-fp_t FP(i32 whole, i32 frac);
+// 8.8, for values that have to be small (OBJ affine matrices are 8.8)
+typedef i16 fp8_t;
+#define FP8_FRACBITS 8
 
-// TODO: finish implementing FP arithmetic.
-// add and subtract work the same as regular
-// integers
+// 24.8, for large values that don't need much precision (world positions)
+typedef i32 fp24_t;
+#define FP24_FRACBITS 8
 
+// Everything here is static inline: most of these are a single shift,
+// cheaper than the BL/BX to get to them
+
+static inline fp_t Int2FP(i32 i)
+{
+    return (fp_t)((u32)i << FP_FRACBITS);
+}
+
+static inline i32 FP2Int(fp_t i)
+{
+    return i >> FP_FRACBITS;
+}
+
+static inline fp_t FP(i32 whole, i32 frac)
+{
+    return Int2FP(whole) | frac;
+}
+
+// round to the nearest integer instead of towards -inf
+static inline i32 FP2IntRound(fp_t i)
+{
+    return (i + (FP_ONE >> 1)) >> FP_FRACBITS;
+}
+
+static inline fp8_t  Int2FP8(i32 i)    { return (fp8_t)((u32)i << FP8_FRACBITS); }
+static inline i32    FP82Int(fp8_t i)  { return i >> FP8_FRACBITS; }
+static inline fp24_t Int2FP24(i32 i)   { return (fp24_t)((u32)i << FP24_FRACBITS); }
+static inline i32    FP242Int(fp24_t i) { return i >> FP24_FRACBITS; }
+
+static inline fp8_t  FP2FP8(fp_t i)    { return (fp8_t)(i >> (FP_FRACBITS - FP8_FRACBITS)); }
+static inline fp_t   FP82FP(fp8_t i)   { return (fp_t)((u32)(i32)i << (FP_FRACBITS - FP8_FRACBITS)); }
+static inline fp24_t FP2FP24(fp_t i)   { return i >> (FP_FRACBITS - FP24_FRACBITS); }
+static inline fp_t   FP242FP(fp24_t i) { return (fp_t)((u32)i << (FP_FRACBITS - FP24_FRACBITS)); }
+
+// add and subtract work the same as regular integers
+
+// the 64-bit product is a single smull on the ARM7
+static inline fp_t fp_mul(fp_t a, fp_t b)
+{
+    return (fp_t)(((int64_t)a * b) >> FP_FRACBITS);
+}
+
+static inline fp8_t fp8_mul(fp8_t a, fp8_t b)
+{
+    return (fp8_t)(((i32)a * b) >> FP8_FRACBITS);
+}
+
+static inline fp24_t fp24_mul(fp24_t a, fp24_t b)
+{
+    return (fp24_t)(((int64_t)a * b) >> FP24_FRACBITS);
+}
+
+// Integer division with remainder, both truncated towards zero.
+// The ARM7 has no divide instruction, the BIOS Div call (SWI 0x06) is
+// the fastest one around. The host build does the same in C so both
+// give the same results
+#ifdef __HOST__
+static inline i32 FP_IDiv(i32 num, i32 den, i32 *rem)
+{
+    *rem = num % den;
+    return num / den;
+}
+#else
+static inline i32 FP_IDiv(i32 num, i32 den, i32 *rem)
+{
+    register i32 r0 __asm__("r0") = num;
+    register i32 r1 __asm__("r1") = den;
+    __asm__ volatile(SWI(0x06) : "+r"(r0), "+r"(r1) :: "r3");
+    *rem = r1;
+    return r0;
+}
+#endif
+
+// a / b. The numerator needs 48 bits and Div only takes 32, so the whole
+// part is divided first and the remainder is brought down 8 fraction bits
+// at a time. Divisors of 128.0 and up are shifted down to make room for
+// that, losing their lowest bits. Results past 32767 overflow
+static inline fp_t fp_div(fp_t a, fp_t b)
+{
+    ASSERT(b != 0);
+
+    u32 neg = (a < 0) != (b < 0);
+    u32 n = (a < 0) ? -(u32)a : (u32)a;
+    u32 d = (b < 0) ? -(u32)b : (u32)b;
+    while((d >= (1u << 23) || n >= (1u << 31)) && d > 1)
+    {
+        n >>= 1;
+        d >>= 1;
+    }
+
+    i32 r;
+    u32 q = FP_IDiv(n, d, &r);
+    q = (q << 8) | FP_IDiv(r << 8, d, &r);
+    q = (q << 8) | FP_IDiv(r << 8, d, &r);
+
+    return neg ? -(fp_t)q : (fp_t)q;
+}
+
+static inline fp_t fp_recip(fp_t a)
+{
+    return fp_div(FP_ONE, a);
+}
+
+// Digit by digit, one result bit per step. 0 for negative input
+static inline fp_t fp_sqrt(fp_t a)
+{
+    if(a <= 0) return 0;
+
+    uint64_t n = (uint64_t)a << FP_FRACBITS;
+    uint64_t root = 0;
+    uint64_t bit = (uint64_t)1 << 46;
+    while(bit > n) bit >>= 2;
+
+    while(bit)
+    {
+        if(n >= root + bit)
+        {
+            n -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (fp_t)root;
+}
+
+// Trig. Angles are in binary units: 0x10000 is a full circle, so they
+// wrap on their own. The tables are generated by tools/lut-gen
+// (fixed_lut.c) and live in ROM
+
+#define FP_ANGLE_FULL 0x10000
+#define FP_SIN_LUT_BITS 9
+#define FP_SIN_LUT_LEN (1 << FP_SIN_LUT_BITS)
+#define FP_SIN_LUT_FRACBITS 12
+#define FP_ATAN_LUT_LEN 257
+
+// sin over a full circle, 4.12
+extern const i16 FP_SinLUT[FP_SIN_LUT_LEN];
+// atan(i / 256) for i in 0..256, in angle units (up to 0x2000)
+extern const u16 FP_AtanLUT[FP_ATAN_LUT_LEN];
+
+static inline fp_t fp_sin(u32 angle)
+{
+    // table step plus linear interpolation on the bits below it
+    const u32 shift = 16 - FP_SIN_LUT_BITS;
+    u32 i = (angle >> shift) & (FP_SIN_LUT_LEN - 1);
+    i32 frac = angle & ((1 << shift) - 1);
+    i32 a = FP_SinLUT[i];
+    i32 b = FP_SinLUT[(i + 1) & (FP_SIN_LUT_LEN - 1)];
+    i32 v = a + (((b - a) * frac) >> shift);
+    return (fp_t)((u32)v << (FP_FRACBITS - FP_SIN_LUT_FRACBITS));
+}
+
+static inline fp_t fp_cos(u32 angle)
+{
+    return fp_sin(angle + FP_ANGLE_FULL / 4);
+}
+
+// Angle of (x, y), 0 along +x and increasing towards +y. Works for any
+// scale of input since only the ratio matters
+static inline u32 fp_atan2(i32 y, i32 x)
+{
+    if(x == 0 && y == 0) return 0;
+
+    u32 ax = (x < 0) ? -(u32)x : (u32)x;
+    u32 ay = (y < 0) ? -(u32)y : (u32)y;
+    u32 lo = (ax < ay) ? ax : ay;
+    u32 hi = (ax < ay) ? ay : ax;
+    while(hi >= (1u << 23))
+    {
+        lo >>= 1;
+        hi >>= 1;
+    }
+
+    // lo / hi in [0, 1] as a table index and an 8-bit fraction
+    i32 r;
+    u32 idx = FP_IDiv(lo << 8, hi, &r);
+    u32 frac = FP_IDiv(r << 8, hi, &r);
+    u32 angle = FP_AtanLUT[idx];
+    if(idx < FP_ATAN_LUT_LEN - 1)
+    {
+        angle += ((FP_AtanLUT[idx + 1] - FP_AtanLUT[idx]) * frac) >> 8;
+    }
+
+    // back out of the first octant
+    if(ay > ax) angle = FP_ANGLE_FULL / 4 - angle;
+    if(x < 0) angle = FP_ANGLE_FULL / 2 - angle;
+    if(y < 0) angle = FP_ANGLE_FULL - angle;
+    return angle & (FP_ANGLE_FULL - 1);
+}
 
 #endif
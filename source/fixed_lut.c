@@ -0,0 +1,77 @@
+// Generated by tools/lut-gen, don't edit by hand
+
+#include "fixed.h"
+
+// sin(2*pi * i / 512), 4.12
+const i16 FP_SinLUT[FP_SIN_LUT_LEN] __attribute__((aligned(4))) = {
+	     0,    50,   101,   151,   201,   251,   301,   351,   401,   451,   501,   551,
+	   601,   651,   700,   750,   799,   848,   897,   946,   995,  1044,  1092,  1141,
+	  1189,  1237,  1285,  1332,  1380,  1427,  1474,  1521,  1567,  1614,  1660,  1706,
+	  1751,  1797,  1842,  1886,  1931,  1975,  2019,  2062,  2106,  2149,  2191,  2234,
+	  2276,  2317,  2359,  2399,  2440,  2480,  2520,  2559,  2598,  2637,  2675,  2713,
+	  2751,  2788,  2824,  2861,  2896,  2932,  2967,  3001,  3035,  3068,  3102,  3134,
+	  3166,  3198,  3229,  3260,  3290,  3320,  3349,  3378,  3406,  3433,  3461,  3487,
+	  3513,  3539,  3564,  3588,  3612,  3636,  3659,  3681,  3703,  3724,  3745,  3765,
+	  3784,  3803,  3822,  3839,  3857,  3873,  3889,  3905,  3920,  3934,  3948,  3961,
+	  3973,  3985,  3996,  4007,  4017,  4027,  4036,  4044,  4052,  4059,  4065,  4071,
+	  4076,  4081,  4085,  4088,  4091,  4093,  4095,  4096,  4096,  4096,  4095,  4093,
+	  4091,  4088,  4085,  4081,  4076,  4071,  4065,  4059,  4052,  4044,  4036,  4027,
+	  4017,  4007,  3996,  3985,  3973,  3961,  3948,  3934,  3920,  3905,  3889,  3873,
+	  3857,  3839,  3822,  3803,  3784,  3765,  3745,  3724,  3703,  3681,  3659,  3636,
+	  3612,  3588,  3564,  3539,  3513,  3487,  3461,  3433,  3406,  3378,  3349,  3320,
+	  3290,  3260,  3229,  3198,  3166,  3134,  3102,  3068,  3035,  3001,  2967,  2932,
+	  2896,  2861,  2824,  2788,  2751,  2713,  2675,  2637,  2598,  2559,  2520,  2480,
+	  2440,  2399,  2359,  2317,  2276,  2234,  2191,  2149,  2106,  2062,  2019,  1975,
+	  1931,  1886,  1842,  1797,  1751,  1706,  1660,  1614,  1567,  1521,  1474,  1427,
+	  1380,  1332,  1285,  1237,  1189,  1141,  1092,  1044,   995,   946,   897,   848,
+	   799,   750,   700,   651,   601,   551,   501,   451,   401,   351,   301,   251,
+	   201,   151,   101,    50,     0,   -50,  -101,  -151,  -201,  -251,  -301,  -351,
+	  -401,  -451,  -501,  -551,  -601,  -651,  -700,  -750,  -799,  -848,  -897,  -946,
+	  -995, -1044, -1092, -1141, -1189, -1237, -1285, -1332, -1380, -1427, -1474, -1521,
+	 -1567, -1614, -1660, -1706, -1751, -1797, -1842, -1886, -1931, -1975, -2019, -2062,
+	 -2106, -2149, -2191, -2234, -2276, -2317, -2359, -2399, -2440, -2480, -2520, -2559,
+	 -2598, -2637, -2675, -2713, -2751, -2788, -2824, -2861, -2896, -2932, -2967, -3001,
+	 -3035, -3068, -3102, -3134, -3166, -3198, -3229, -3260, -3290, -3320, -3349, -3378,
+	 -3406, -3433, -3461, -3487, -3513, -3539, -3564, -3588, -3612, -3636, -3659, -3681,
+	 -3703, -3724, -3745, -3765, -3784, -3803, -3822, -3839, -3857, -3873, -3889, -3905,
+	 -3920, -3934, -3948, -3961, -3973, -3985, -3996, -4007, -4017, -4027, -4036, -4044,
+	 -4052, -4059, -4065, -4071, -4076, -4081, -4085, -4088, -4091, -4093, -4095, -4096,
+	 -4096, -4096, -4095, -4093, -4091, -4088, -4085, -4081, -4076, -4071, -4065, -4059,
+	 -4052, -4044, -4036, -4027, -4017, -4007, -3996, -3985, -3973, -3961, -3948, -3934,
+	 -3920, -3905, -3889, -3873, -3857, -3839, -3822, -3803, -3784, -3765, -3745, -3724,
+	 -3703, -3681, -3659, -3636, -3612, -3588, -3564, -3539, -3513, -3487, -3461, -3433,
+	 -3406, -3378, -3349, -3320, -3290, -3260, -3229, -3198, -3166, -3134, -3102, -3068,
+	 -3035, -3001, -2967, -2932, -2896, -2861, -2824, -2788, -2751, -2713, -2675, -2637,
+	 -2598, -2559, -2520, -2480, -2440, -2399, -2359, -2317, -2276, -2234, -2191, -2149,
+	 -2106, -2062, -2019, -1975, -1931, -1886, -1842, -1797, -1751, -1706, -1660, -1614,
+	 -1567, -1521, -1474, -1427, -1380, -1332, -1285, -1237, -1189, -1141, -1092, -1044,
+	  -995,  -946,  -897,  -848,  -799,  -750,  -700,  -651,  -601,  -551,  -501,  -451,
+	  -401,  -351,  -301,  -251,  -201,  -151,  -101,   -50
+};
+
+// atan(i / 256), 0x10000 units to the circle
+const u16 FP_AtanLUT[FP_ATAN_LUT_LEN] __attribute__((aligned(4))) = {
+	     0,    41,    81,   122,   163,   204,   244,   285,   326,   367,   407,   448,
+	   489,   529,   570,   610,   651,   692,   732,   773,   813,   854,   894,   935,
+	   975,  1015,  1056,  1096,  1136,  1177,  1217,  1257,  1297,  1337,  1377,  1417,
+	  1457,  1497,  1537,  1577,  1617,  1656,  1696,  1736,  1775,  1815,  1854,  1894,
+	  1933,  1973,  2012,  2051,  2090,  2129,  2168,  2207,  2246,  2285,  2324,  2363,
+	  2401,  2440,  2478,  2517,  2555,  2594,  2632,  2670,  2708,  2746,  2784,  2822,
+	  2860,  2897,  2935,  2973,  3010,  3047,  3085,  3122,  3159,  3196,  3233,  3270,
+	  3307,  3344,  3380,  3417,  3453,  3490,  3526,  3562,  3599,  3635,  3670,  3706,
+	  3742,  3778,  3813,  3849,  3884,  3920,  3955,  3990,  4025,  4060,  4095,  4129,
+	  4164,  4199,  4233,  4267,  4302,  4336,  4370,  4404,  4438,  4471,  4505,  4539,
+	  4572,  4605,  4639,  4672,  4705,  4738,  4771,  4803,  4836,  4869,  4901,  4933,
+	  4966,  4998,  5030,  5062,  5094,  5125,  5157,  5188,  5220,  5251,  5282,  5313,
+	  5344,  5375,  5406,  5437,  5467,  5498,  5528,  5559,  5589,  5619,  5649,  5679,
+	  5708,  5738,  5768,  5797,  5826,  5856,  5885,  5914,  5943,  5972,  6000,  6029,
+	  6058,  6086,  6114,  6142,  6171,  6199,  6227,  6254,  6282,  6310,  6337,  6365,
+	  6392,  6419,  6446,  6473,  6500,  6527,  6554,  6580,  6607,  6633,  6660,  6686,
+	  6712,  6738,  6764,  6790,  6815,  6841,  6867,  6892,  6917,  6943,  6968,  6993,
+	  7018,  7043,  7068,  7092,  7117,  7141,  7166,  7190,  7214,  7238,  7262,  7286,
+	  7310,  7334,  7358,  7381,  7405,  7428,  7451,  7475,  7498,  7521,  7544,  7566,
+	  7589,  7612,  7635,  7657,  7679,  7702,  7724,  7746,  7768,  7790,  7812,  7834,
+	  7856,  7877,  7899,  7920,  7942,  7963,  7984,  8005,  8026,  8047,  8068,  8089,
+	  8110,  8131,  8151,  8172,  8192
+};
+
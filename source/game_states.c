@@ -4,10 +4,20 @@
 #include "game_states.h"
 #include "bit_control.h"
 #include "fixed.h"
+#include "dma.h"
+#include "mem.h"
+#include "obj_budget.h"
+#include "obj_mux.h"
+#include "profile.h"
+#include "replay.h"
+#include "residency.h"
+#include "tile_stream.h"
 
 #include "256Palette.h"
 #include "sprites.h"
 
+u32 Game_MuxEntries = 0;
+
 i32
 WrapY(i32 y)
 {
@@ -54,6 +64,31 @@ u16 PlayerCollideBorder(Player *player, ScreenDim *screenDim)
 	return 0;
 }
 
+// frame #s refer to attr2 charname, durations are in frames (60Hz)
+static const AnimationDef Player_Flap = {
+    (const u16[]){
+        SPRITE_Robo_1_CHARNAME,
+        SPRITE_Robo_2_CHARNAME,
+        SPRITE_Robo_2_CHARNAME,
+        SPRITE_Robo_3_CHARNAME,
+        SPRITE_Robo_3_CHARNAME,
+        SPRITE_Robo_4_CHARNAME,
+        SPRITE_Robo_4_CHARNAME,
+        SPRITE_Robo_5_CHARNAME
+    },
+    (const u8[]){ 2, 2, 2, 2, 2, 2, 2, 2 },
+    8, FALSE
+};
+
+static const AnimationDef ButtonA_Press = {
+    (const u16[]){
+        SPRITE_ButtonA_dark_CHARNAME,
+        SPRITE_ButtonA_light_CHARNAME
+    },
+    (const u8[]){ 7, 7 },
+    2, FALSE
+};
+
 Player
 Player_Create(u32 oamIdx, u32 x, u32 y, Rectangle bounding_box, fp_t velX, fp_t velY)
 {
@@ -65,55 +100,59 @@ Player_Create(u32 oamIdx, u32 x, u32 y, Rectangle bounding_box, fp_t velX, fp_t
     player.bounding_box = bounding_box;
     player.velX = velX;
     player.velY = velY;
-    player.anim = Animation_Create(
-            (u32[]){
-                SPRITE_Robo_1_CHARNAME,
-                SPRITE_Robo_2_CHARNAME,
-                SPRITE_Robo_2_CHARNAME,
-                SPRITE_Robo_3_CHARNAME,
-                SPRITE_Robo_3_CHARNAME,
-                SPRITE_Robo_4_CHARNAME,
-                SPRITE_Robo_4_CHARNAME,
-                SPRITE_Robo_5_CHARNAME
-            }, //frame #s refer to attr2 charname
-            8, 30, FALSE
-    );
+    player.anim = AnimationBank_Add(&Player_Flap);
 
     return player;
 }
 
-void UpdateOBJPos(OBJ_ATTR *obj, int x, int y)
+// the Robo frames are 32 chars apart
+const u32 *Player_Mask(const Player *player)
+{
+    static const u32 *const roboMasks[] = {
+        SPRITE_Robo_1_MASK,
+        SPRITE_Robo_2_MASK,
+        SPRITE_Robo_3_MASK,
+        SPRITE_Robo_4_MASK,
+        SPRITE_Robo_5_MASK
+    };
+    u32 charName = Animation_CharName(player->anim);
+    u32 frame = (charName - SPRITE_Robo_1_CHARNAME) >> 5;
+    ASSERT(frame < ARR_LENGTH(roboMasks));
+    return roboMasks[frame];
+}
+
+IWRAM_CODE void UpdateOBJPos(OBJ_ATTR *obj, int x, int y)
 {
     BF_SET(&obj->attr1, x, ATTR1_XCOORD_LEN, ATTR1_XCOORD_SHIFT);
     BF_SET(&obj->attr0, y, ATTR0_YCOORD_LEN, ATTR0_YCOORD_SHIFT);
 }
 
-// Create a new Obstacle struct and setup its associated OAM OBJs
-Obstacle
-ObstacleCreate(
-	OBJ_ATTR* OAM_objs,
-	OBJPool* obstaclePool,
-	xorshift32_state* randState
+// Create a new obstacle in `slot` and setup its associated OAM OBJs
+u32
+Obstacle_Create(
+	ObstacleSet *set,
+	u32 slot,
+	OBJPool* objPool,
+	RandRing* rand
 	)
 {
-    Obstacle Result = {0};
+	i32 x = OBSTACLE_START_X;
+    u32 gapSize = RandRing_Range(rand, OBSTACLE_GAP_MIN, OBSTACLE_GAP_MAX);
+	u32 y = RandRing_Range(rand, gapSize / 2 + OBSTACLE_GAP_MARGIN, SCREEN_HEIGHT - (gapSize / 2) - OBSTACLE_GAP_MARGIN);
 
-	Result.x = OBSTACLE_START_X;
-    Result.gapSize = xorshift32_range(randState, 50, 96);
-	Result.y = xorshift32_range(randState, Result.gapSize / 2 + 16, 160 - (Result.gapSize / 2) - 16);
-    Result.active = 1;
+    set->x[slot] = x;
+    set->y[slot] = y;
+    set->gapSize[slot] = gapSize;
+    set->countedScore &= ~(1 << slot);
 
-    // calculate the number of tiles needed on the top, including the end tile
-    // the division will truncate the number which means that we need to add 1 to make sure
-    //     there's a tile that will reach the edge of the screen
-    i32 numTilesToTopBorder = (Result.y - (Result.gapSize / 2)) / 32 + 1;
-    i32 numTilesToBtmBorder = (SCREEN_HEIGHT - ((i32)Result.y + ((i32)Result.gapSize / 2))) / 32 + 1;
+    i32 numTilesToTopBorder, numTilesToBtmBorder;
+    Obstacle_ColumnTiles(y, gapSize, &numTilesToTopBorder, &numTilesToBtmBorder);
 
 #ifdef __DEBUG__
     char debug_msg[DEBUG_MSG_LEN];
 	mgba_printf(DEBUG_DEBUG, "Creating a new obstacle...");
 	
-	snprintf(debug_msg, DEBUG_MSG_LEN, "y: %ld, gap: %ld", Result.y, Result.gapSize);
+	snprintf(debug_msg, DEBUG_MSG_LEN, "y: %ld, gap: %ld", y, gapSize);
 	mgba_printf(DEBUG_DEBUG, debug_msg);
 
     snprintf(debug_msg, DEBUG_MSG_LEN, "Number top tiles: %ld", numTilesToTopBorder);
@@ -123,72 +162,81 @@ ObstacleCreate(
     mgba_printf(DEBUG_DEBUG, debug_msg);
 #endif
 
-    i32 objPoolIdx = 0;
+    // all the tiles in one run of OAM entries
+    u32 numTiles = numTilesToTopBorder + numTilesToBtmBorder;
+    ASSERT(numTiles <= MAX_TILES_LEN);
+    ASSERT(set->tileCount + numTiles <= OBSTACLE_TILES_MAX);
+    i32 oamBase = OBJPool_Acquire(objPool, numTiles);
+    if(oamBase == OBJPOOL_NONE)
+    {
+        set->active &= ~(1 << slot);
+        return FALSE;
+    }
+    set->oamBase[slot] = oamBase;
+    set->active |= 1 << slot;
 
-    for(u32 i = 0; i < numTilesToTopBorder + numTilesToBtmBorder; i++)
+    for(u32 i = 0; i < numTiles; i++)
     {
-        // setup the obstacle tile struct
-        objPoolIdx = OBJPool_GetNextIdx(obstaclePool);
-        Result.tiles[i].oamIdx = obstaclePool->indexes[objPoolIdx];
-        Result.tiles[i].active = 1;
+        // setup the obstacle tile, at the end of the live list
+        u32 t = set->tileCount++;
+        i32 tileY;
+        u32 flags = slot;
+        set->tileOAM[t] = oamBase + i;
+
+        OBJ_ATTR *obj = OAM_Touch(oamBase + i);
 
         // handle differences between top and btm tiles
         if(i < numTilesToTopBorder)
         {
-            Result.tiles[i].y = Result.y - (Result.gapSize / 2) - (OBSTACLE_TILE_SIZE * (i + 1));
+            tileY = y - (gapSize / 2) - (OBSTACLE_TILE_SIZE * (i + 1));
         }
         else {
-            Result.tiles[i].y = Result.y + (Result.gapSize / 2) + (OBSTACLE_TILE_SIZE * (i - numTilesToTopBorder));
-            BIT_SET(&OAM_objs[obstaclePool->indexes[objPoolIdx]].attr1, ATTR1_FLIPVERT);
+            tileY = y + (gapSize / 2) + (OBSTACLE_TILE_SIZE * (i - numTilesToTopBorder));
+            BIT_SET(&obj->attr1, ATTR1_FLIPVERT);
+            flags |= OBSTACLE_TILE_FLIPV;
         }
 
         // wrap the tile vertically if it goes out of bounds
-		Result.tiles[i].y = WrapY(Result.tiles[i].y);
+		set->tileY[t] = WrapY(tileY);
 
         // setup the obstacle sprite in OAM
-        BF_SET(&OAM_objs[obstaclePool->indexes[objPoolIdx]].attr0, 1, 1, ATTR0_COLORMODE);
-        BF_SET(&OAM_objs[obstaclePool->indexes[objPoolIdx]].attr1, 2, 2, ATTR1_OBJSIZE);
-        BF_SET(&OAM_objs[obstaclePool->indexes[objPoolIdx]].attr1, Result.x, ATTR1_XCOORD_LEN, ATTR1_XCOORD_SHIFT);
-        BF_SET(&OAM_objs[obstaclePool->indexes[objPoolIdx]].attr0, Result.y, ATTR0_YCOORD_LEN, ATTR0_YCOORD_SHIFT);
+        BF_SET(&obj->attr0, 1, 1, ATTR0_COLORMODE);
+        BF_SET(&obj->attr1, 2, 2, ATTR1_OBJSIZE);
+        BF_SET(&obj->attr1, x, ATTR1_XCOORD_LEN, ATTR1_XCOORD_SHIFT);
+        BF_SET(&obj->attr0, y, ATTR0_YCOORD_LEN, ATTR0_YCOORD_SHIFT);
         // the first two tiles should be end-pieces
         if(i == 0 || i == numTilesToTopBorder)
         {
             // TODO: the starting tile is #16 in the tile set but the char name for
             // this sprite needs to be 32... why? what is a "char name" (attr2)?
             BF_SET(
-                &OAM_objs[obstaclePool->indexes[objPoolIdx]].attr2,
+                &obj->attr2,
                 SPRITE_Obstacle_End_CHARNAME,
                 ATTR2_CHARNAME_LEN,
                 ATTR2_CHARNAME_SHIFT
             );
+            flags |= OBSTACLE_TILE_END;
         }
         else
         {
             // every other tile but the first should use a tiling sprite
             BF_SET(
-                &OAM_objs[obstaclePool->indexes[objPoolIdx]].attr2,
+                &obj->attr2,
                 SPRITE_Obstacle_Tile_01_CHARNAME,
                 ATTR2_CHARNAME_LEN,
                 ATTR2_CHARNAME_SHIFT
             );
         }
-        BIT_CLEAR(&OAM_objs[obstaclePool->indexes[objPoolIdx]].attr0, ATTR0_DISABLE);
+        BIT_CLEAR(&obj->attr0, ATTR0_DISABLE);
+        set->tileFlags[t] = flags;
     }
 
-    // create the bounding boxes for the obstacle
-    Result.bounding_box_top = Rectangle_Create(0, -Result.y, 24, Result.y - Result.gapSize / 2);
-    Result.bounding_box_btm = Rectangle_Create(0, Result.gapSize / 2, 24, SCREEN_HEIGHT - Result.y);
-
 #ifdef __DEBUG__
-	snprintf(debug_msg, DEBUG_MSG_LEN, "top: x: %ld, y: %ld, w: %ld, h: %ld", Result.bounding_box_top.x, Result.bounding_box_top.y, Result.bounding_box_top.w, Result.bounding_box_top.h);
-	mgba_printf(DEBUG_DEBUG, debug_msg);
-
-	snprintf(debug_msg, DEBUG_MSG_LEN, "btm: x: %ld, y: %ld, w: %ld, h: %ld", Result.bounding_box_btm.x, Result.bounding_box_btm.y, Result.bounding_box_btm.w, Result.bounding_box_btm.h);
+	snprintf(debug_msg, DEBUG_MSG_LEN, "top: y: %ld, h: %ld, btm: y: %ld, h: %ld", -(i32)y, y - gapSize / 2, gapSize / 2, SCREEN_HEIGHT - y);
 	mgba_printf(DEBUG_DEBUG, debug_msg);
 #endif
 
-
-    return Result;
+    return TRUE;
 }
 
 void OAM_OBJClear(i32 idx)
@@ -199,40 +247,104 @@ void OAM_OBJClear(i32 idx)
     mgba_printf(DEBUG_DEBUG, debug_msg);
 #endif
     // zero out the given OAM OBJ and then disable it
-	OBJ_ATTR *obj = (OBJ_ATTR *)OAM_MEM;
-    obj[idx] = (OBJ_ATTR){0};
+	OBJ_ATTR *obj = OAM_Touch(idx);
+    *obj = (OBJ_ATTR){0};
 
-    BIT_SET(&OAM_MEM[idx], ATTR0_DISABLE);
+    BIT_SET(&obj->attr0, ATTR0_DISABLE);
 }
 
-void Obstacle_Clear(Obstacle* obstacle)
+// Disable the obstacle's OAM OBJs, take its tiles out of the live list
+// and zero out its fields
+void Obstacle_Clear(ObstacleSet *set, u32 slot, OBJPool* objPool)
 {
-    // iterate over each of the Obstacle's tiles and disable them
-    for(size_t i = 0; i < ARR_LENGTH(obstacle->tiles); i++)
+    // the tiles were acquired as one run starting at the base
+    if(Obstacle_Active(set, slot))
     {
-        if(obstacle->tiles[i].active)
-        {
-            OAM_OBJClear(obstacle->tiles[i].oamIdx);
-            obstacle->tiles[i].active = 0;
-        }
+        OBJPool_Release(objPool, set->oamBase[slot]);
     }
+
+    // disable each of the obstacle's tiles, filling its place in the list
+    // from the end
+    for(u32 t = 0; t < set->tileCount; )
+    {
+        if((set->tileFlags[t] & OBSTACLE_TILE_SLOT_MASK) != slot) { t++; continue; }
+
+        OAM_OBJClear(set->tileOAM[t]);
+        u32 last = --set->tileCount;
+        set->tileY[t] = set->tileY[last];
+        set->tileOAM[t] = set->tileOAM[last];
+        set->tileFlags[t] = set->tileFlags[last];
+    }
+
+    set->x[slot] = 0;
+    set->y[slot] = 0;
+    set->gapSize[slot] = 0;
+    set->oamBase[slot] = 0;
+    set->active &= ~(1 << slot);
+    set->countedScore &= ~(1 << slot);
 }
 
+void Obstacle_AddColliders(const ObstacleSet *set, u32 slot, ColliderSet* colliders)
+{
+    i32 x = set->x[slot];
+    u32 y = set->y[slot];
+    u32 gapSize = set->gapSize[slot];
 
+    // the top box runs from the top of the screen, the bottom one to the
+    // bottom, both relative to the gap center
+    Rectangle top = Rectangle_Create(x, 0, OBSTACLE_BOX_W, y - gapSize / 2);
+    Rectangle btm = Rectangle_Create(x, y + gapSize / 2, OBSTACLE_BOX_W, SCREEN_HEIGHT - y);
 
-GameStates
+    ColliderSet_Add(colliders, &top, slot);
+    ColliderSet_Add(colliders, &btm, slot);
+}
+
+IWRAM_CODE u32 Obstacle_CollideMask(const ObstacleSet *set, u32 slot, const CollisionMask* mask)
+{
+    for(u32 t = 0; t < set->tileCount; t++)
+    {
+        u32 flags = set->tileFlags[t];
+        if((flags & OBSTACLE_TILE_SLOT_MASK) != slot) continue;
+
+        // tiles above the screen were wrapped to the bottom of OBJ space
+        i32 y = (set->tileY[t] >= SCREEN_HEIGHT) ? set->tileY[t] - (OBJMAXY + 1) : set->tileY[t];
+        CollisionMask tileMask = {
+            (flags & OBSTACLE_TILE_END) ? SPRITE_Obstacle_End_MASK : SPRITE_Obstacle_Tile_01_MASK,
+            set->x[slot],
+            y,
+            OBSTACLE_TILE_SIZE,
+            (flags & OBSTACLE_TILE_FLIPV) != 0
+        };
+        if(CheckCollision_MaskMask(mask, &tileMask)) return 1;
+    }
+    return 0;
+}
+
+
+
+// redraw the score digits marked since the last draw
+static inline void Game_DrawScore(GameScreenState *state)
+{
+#ifdef GAME_SCORE_BG
+    Score_DrawBG(&state->score, BG_TxtMode_Screens[GAME_HUD_MAPBLOCK], GAME_HUD_TILE);
+#else
+    Score_DrawOBJ(&state->score, state->scoreCounterOAMIdxs, SPRITE_Numbers_0_CHARNAME,
+        SPRITE_Numbers_1_CHARNAME - SPRITE_Numbers_0_CHARNAME);
+#endif
+}
+
+void
 gameState_SplashScreenInit(SplashScreenState *state)
 {
-    return GAMESTATE_SPLASHSCREEN;
 }
 
 GameStates
 gameState_SplashScreen(SplashScreenState *state)
 {
-	return GAMESTATE_SPLASHSCREENDEINIT;
+	return GAMESTATE_TITLESCREEN;
 }
 
-GameStates
+void
 gameState_GameInit(GameScreenState *state)
 {
 
@@ -256,130 +368,168 @@ gameState_GameInit(GameScreenState *state)
 	BF_SET(BG0CNT, bgMapBaseBlock, 5, BGXCNT_SCRNBASEBLOCK); // select bg map base block
 	BF_SET(BG0CNT, 2, 2, BGXCNT_SCREENSIZE); // select map size (64x32 tiles, or 2x 32x32-tile screens, side-by-side)
 
+#ifdef GAME_SCORE_BG
+	// the score HUD on BG1, in front of the scrolling BG0. The scroll
+	// puts the map's top left 5 pixels in from the screen's
+	BIT_SET(REG_DISPCNT, DISPCNT_BG1FLAG_SHIFT);
+	BF_SET(BG0CNT, 1, 2, BGXCNT_PRIORITY);
+	*BG1CNT = 0;
+	BIT_SET(BG1CNT, BGXCNT_COLORMODE);
+	BF_SET(BG1CNT, bgCharBaseBlock, 2, BGXCNT_CHARBASEBLOCK);
+	BF_SET(BG1CNT, GAME_HUD_MAPBLOCK, 5, BGXCNT_SCRNBASEBLOCK);
+	*BG1HOFS = -5;
+	*BG1VOFS = -5;
+#endif
+
     // setup important scene items
 	state->inputs = (InputState){0};
 	state->screenDim = (ScreenDim){ 0, 0, 240, 160 };
-    state->player = Player_Create(4, 60, 80, Rectangle_Create(8, 9, 21, 14), 0, 0);
-    state->obstaclePool = OBJPool_Create(104, 24); // 6 tiles per obstacle, 4 obstacles in use at a time
+    // the OAM entries kept for the whole session have their own fixed
+    // range at the bottom, the pool hands out the ones past it
+    OBJPool_Init(&state->objPool);
+    OBJPool_Reserve(&state->objPool, GAME_OAM_SCORE, GAME_OAM_FIXED);
+    state->buttonOAMIdx = GAME_OAM_BUTTON;
+    ASSERT(Game_MuxEntries <= GAME_MUX_ENTRIES);
+    if(Game_MuxEntries) OBJPool_Reserve(&state->objPool, OAM_COUNT - Game_MuxEntries, Game_MuxEntries);
+    OBJMux_Init(OAM_COUNT - Game_MuxEntries, Game_MuxEntries);
+
+    // the scene's animations come out of the bank, emptied every session
+    AnimationBank_Clear();
+    state->player = Player_Create(GAME_OAM_PLAYER, 60, 80, Rectangle_Create(8, 9, 21, 14), 0, 0);
 	state->frameCounter = 1;
-    state->score = 0;
+    Score_Init(&state->score, GAME_SCORE_DIGITS, 0);
+    state->onTitleScreen = 1;
     state->GravityPerFrame = FP(0, 0x4000);
-    state->aButtonAnimation = Animation_Create(
-        (u32[]){
-            SPRITE_ButtonA_dark_CHARNAME,
-            SPRITE_ButtonA_light_CHARNAME
-        },
-        2, 8, FALSE
-    );
+    state->aButtonAnimation = AnimationBank_Add(&ButtonA_Press);
 
     Animation_Play(state->player.anim);
 
 	// setup the random number generator
-    state->randState = (xorshift32_state){69420};
+    RandRing_Init(&state->rand, GAME_SEED);
 
-	// copy the palette data to the BG and OBJ palettes
-	memcpy(BGPAL_MEM, Pal256, PalLen256);
-	memcpy(OBJPAL_MEM, Pal256, PalLen256);
+    // keep recording across game overs, until a replay is started or SRAM
+    // runs out. sessions always start here so replays can too
+    if(Replay_State.mode == REPLAY_OFF) Replay_Record(GAME_SEED);
 
-    // copy all sprite data into VRAM
+	// copy the palette data to the BG and OBJ palettes, unless they're
+	// still there from the last session
+    Residency_Begin();
+    if(Residency_Stale(GAME_ASSET_BGPAL))
+    {
+        DMA_Copy32(DMA_CHANNEL_GENERAL, BGPAL_MEM, Pal256, PalLen256 / 4);
+        Residency_Uploaded(GAME_ASSET_BGPAL, "BG palette", PalLen256);
+    }
+    if(Residency_Stale(GAME_ASSET_OBJPAL))
+    {
+        DMA_Copy32(DMA_CHANNEL_GENERAL, OBJPAL_MEM, Pal256, PalLen256 / 4);
+        Residency_Uploaded(GAME_ASSET_OBJPAL, "OBJ palette", PalLen256);
+    }
+
+    // copy the resident sprite data into VRAM, the player's frames past
+    // the first are streamed in as they come up
     // compiled using tile-builder, extra metadata in `sprites.h`
-	// TODO: see about timing the memcpy
-	// 		 look into using DMA transfers for potential speedup
-	memcpy(&tile8_mem[4][0], SpriteTiles, SPRITETILES_LEN);
+    if(Residency_Stale(GAME_ASSET_OBJTILES))
+    {
+        DMA_Copy32(DMA_CHANNEL_GENERAL, &tile8_mem[4][0], SpriteTiles, GAME_RESIDENT_CHARS * 32 / 4);
+        Residency_Uploaded(GAME_ASSET_OBJTILES, "OBJ tiles", GAME_RESIDENT_CHARS * 32);
+    }
+#ifdef GAME_SCORE_BG
+    // the digit sprites' tiles, in the same order as BG tiles. BG1's map
+    // is left blank but for the digits
+    if(Residency_Stale(GAME_ASSET_HUD))
+    {
+        DMA_Copy32(DMA_CHANNEL_GENERAL, &tile8_mem[0][GAME_HUD_TILE], SpriteTiles + SPRITE_Numbers_0_CHARNAME * 32, 10 * 8 * 32 / 4);
+        memset32(BG_TxtMode_Screens[GAME_HUD_MAPBLOCK], 0, 1024 / 2);
+        Residency_Uploaded(GAME_ASSET_HUD, "HUD", 10 * 8 * 32 + 1024 * sizeof(BG_TxtMode_Tile));
+    }
+#endif
+    TileStream_Init(SpriteTiles, GAME_RESIDENT_CHARS);
+    state->playerTileStream = TileStream_Add(state->player.oamIdx, SPRITE_Robo_1_WIDTH * SPRITE_Robo_1_HEIGHT / 32);
 
     // initialize OAM items
-	OBJ_ATTR *OAM_objs = (OBJ_ATTR *)OAM_MEM;
+    // all sprite changes go through OAM_Touch, see `oam.h`
 	OAM_Init();
 
-    // TODO: make it easier to get OAM indices instead of hardcoding them
-    // setup the score counter sprites
-    state->scoreCounterOAMIdxs[0] = 0;
-    state->scoreCounterOAMIdxs[1] = 1;
-    state->scoreCounterOAMIdxs[2] = 2;
-    state->scoreCounterOAMIdxs[3] = 3;
+#ifndef GAME_SCORE_BG
+    // setup the score counter sprites, their digits are drawn below
+    for(u32 i = 0; i < ARR_LENGTH(state->scoreCounterOAMIdxs); i++)
+    {
+        state->scoreCounterOAMIdxs[i] = GAME_OAM_SCORE + i;
+    }
     for(u32 i = 0; i < ARR_LENGTH(state->scoreCounterOAMIdxs); i++)
     {
-        BIT_SET(&OAM_objs[state->scoreCounterOAMIdxs[i]].attr0, ATTR0_COLORMODE);
-        BF_SET(&OAM_objs[state->scoreCounterOAMIdxs[i]].attr1, SPRITE_Numbers_0_OBJSIZE, ATTR1_OBJSIZE_LEN, ATTR1_OBJSIZE);
-        BF_SET(&OAM_objs[state->scoreCounterOAMIdxs[i]].attr2, SPRITE_Numbers_0_CHARNAME, ATTR2_CHARNAME_LEN, ATTR2_CHARNAME_SHIFT);
-        BF_SET(&OAM_objs[state->scoreCounterOAMIdxs[i]].attr1, 5 + i * 16, ATTR1_XCOORD_LEN, ATTR1_XCOORD_SHIFT);
-        BF_SET(&OAM_objs[state->scoreCounterOAMIdxs[i]].attr0, 5, ATTR0_YCOORD_LEN, ATTR0_YCOORD_SHIFT);
-        BIT_CLEAR(&OAM_objs[state->scoreCounterOAMIdxs[i]].attr0, ATTR0_DISABLE);
+        OBJ_ATTR *obj = OAM_Touch(state->scoreCounterOAMIdxs[i]);
+        BIT_SET(&obj->attr0, ATTR0_COLORMODE);
+        BF_SET(&obj->attr1, SPRITE_Numbers_0_OBJSIZE, ATTR1_OBJSIZE_LEN, ATTR1_OBJSIZE);
+        BF_SET(&obj->attr1, 5 + i * 16, ATTR1_XCOORD_LEN, ATTR1_XCOORD_SHIFT);
+        BF_SET(&obj->attr0, 5, ATTR0_YCOORD_LEN, ATTR0_YCOORD_SHIFT);
     }
+#endif
+    Game_DrawScore(state);
 
 	// setup the robot's sprite
-	BIT_SET(&OAM_objs[state->player.oamIdx].attr0, ATTR0_COLORMODE);
-	BF_SET(&OAM_objs[state->player.oamIdx].attr1, state->player.x, ATTR1_XCOORD_LEN, ATTR1_XCOORD_SHIFT);
-	BF_SET(&OAM_objs[state->player.oamIdx].attr0, state->player.y, ATTR0_YCOORD_LEN, ATTR0_YCOORD_SHIFT);
-	BIT_CLEAR(&OAM_objs[state->player.oamIdx].attr0, ATTR0_DISABLE);
-	BF_SET(&OAM_objs[state->player.oamIdx].attr1, SPRITE_Robo_1_OBJSIZE, 2, ATTR1_OBJSIZE);
-	BF_SET(&OAM_objs[state->player.oamIdx].attr2, state->player.anim->curFrame, ATTR2_CHARNAME_LEN, ATTR2_CHARNAME_SHIFT);
+	OBJ_ATTR *playerObj = OAM_Touch(state->player.oamIdx);
+	BIT_SET(&playerObj->attr0, ATTR0_COLORMODE);
+	BF_SET(&playerObj->attr1, state->player.x, ATTR1_XCOORD_LEN, ATTR1_XCOORD_SHIFT);
+	BF_SET(&playerObj->attr0, state->player.y, ATTR0_YCOORD_LEN, ATTR0_YCOORD_SHIFT);
+	BIT_CLEAR(&playerObj->attr0, ATTR0_DISABLE);
+	BF_SET(&playerObj->attr1, SPRITE_Robo_1_OBJSIZE, 2, ATTR1_OBJSIZE);
+	BF_SET(&playerObj->attr2, Animation_CharName(state->player.anim), ATTR2_CHARNAME_LEN, ATTR2_CHARNAME_SHIFT);
 
 	// setup the title screen button
-    // TODO: make it easier to identify which OAM OBJ to modify (instead of using numbers)
-	BIT_SET(&OAM_objs[5].attr0, ATTR0_COLORMODE);
-	BF_SET(&OAM_objs[5].attr1, 160, ATTR1_XCOORD_LEN, ATTR1_XCOORD_SHIFT);
-	BF_SET(&OAM_objs[5].attr0, 65, ATTR0_YCOORD_LEN, ATTR0_YCOORD_SHIFT);
-	BIT_CLEAR(&OAM_objs[5].attr0, ATTR0_DISABLE);
-	BF_SET(&OAM_objs[5].attr1, SPRITE_ButtonA_light_OBJSIZE, 2, ATTR1_OBJSIZE);
-	BF_SET(&OAM_objs[5].attr2, SPRITE_ButtonA_light_CHARNAME, ATTR2_CHARNAME_LEN, ATTR2_CHARNAME_SHIFT);
+	OBJ_ATTR *buttonObj = OAM_Touch(state->buttonOAMIdx);
+	BIT_SET(&buttonObj->attr0, ATTR0_COLORMODE);
+	BF_SET(&buttonObj->attr1, 160, ATTR1_XCOORD_LEN, ATTR1_XCOORD_SHIFT);
+	BF_SET(&buttonObj->attr0, 65, ATTR0_YCOORD_LEN, ATTR0_YCOORD_SHIFT);
+	BIT_CLEAR(&buttonObj->attr0, ATTR0_DISABLE);
+	BF_SET(&buttonObj->attr1, SPRITE_ButtonA_light_OBJSIZE, 2, ATTR1_OBJSIZE);
+	BF_SET(&buttonObj->attr2, SPRITE_ButtonA_light_CHARNAME, ATTR2_CHARNAME_LEN, ATTR2_CHARNAME_SHIFT);
 
 #if __DEBUG__
-    // test the OBJPool system by making sure the index numbers
-    // wrap properly within the pool and also by filling the
-    // OAM objs using the pool
-    //for(size_t i = 0; i < 32; i++)
-    //{
-    //    i32 poolIdx = OBJPool_GetNextIdx(&state->obstaclePool);
-    //    i32 objIdx = state->obstaclePool.indexes[poolIdx];
-    //    snprintf(debug_msg, DEBUG_MSG_LEN,
-    //            "obstaclePool[%ld]: %ld",
-    //            poolIdx, objIdx);
-    //    mgba_printf(DEBUG_DEBUG, debug_msg);
-    //    BIT_SET(&OAM_objs[objIdx].attr0, ATTR0_COLORMODE);
-    //    BF_SET(&OAM_objs[objIdx].attr1, 2, 2, ATTR1_OBJSIZE);
-    //    BF_SET(&OAM_objs[objIdx].attr2, 0, ATTR2_CHARNAME_LEN, ATTR2_CHARNAME_SHIFT);
-    //}
     debug_msg[0] = '\0';
     debug_msg[0] = debug_msg[0]; // shut up unused var warning
 #endif
 
-	// dummy BG tile art
-	// the number corresponds to the color idx in the palette
-	char smileyTile[64] = {
-		55, 55, 55, 55, 55, 55, 55, 55,
-		55, 55, 55, 55, 55, 55, 55, 55,
-		55, 55,  1, 55, 55,  1, 55, 55,
-		 1, 55,  1, 55, 55,  1, 55,  1,
-		 1, 55, 55, 55, 55, 55, 55,  1,
-		55,  1, 55, 55, 55, 55,  1, 55,
-		55, 55,  1,  1,  1,  1, 55, 55,
-		55, 55, 55, 55, 55, 55, 55, 55,
-	};
-	memcpy(&tile8_mem[0][2], &smileyTile, 64);
-	char blankTile[64] = {
-		55, 55, 55, 55, 55, 55, 55, 55,
-		55, 55, 55, 55, 55, 55, 55, 55,
-		55, 55, 55, 55, 55, 55, 55, 55,
-		55, 55, 55, 55, 55, 55, 55, 55,
-		55, 55, 55, 55, 55, 55, 55, 55,
-		55, 55, 55, 55, 55, 55, 55, 55,
-		55, 55, 55, 55, 55, 55, 55, 55,
-		55, 55, 55, 55, 55, 55, 55, 55
-	};
-	memcpy(&tile8_mem[0][1], &blankTile, 64);
-
-	// Create a basic tilemap
-	BG_TxtMode_Tile blankTileIdx = 1; // first non-zero BG tile
-	*BG_TxtMode_Screens[0] = 0;
-	for(size_t i = 0; i < 2; i++)
-	{
-		for(size_t j = 0; j < 1024; j++)
-		{
-			BG_TxtMode_Screens[bgMapBaseBlock + i][j] = blankTileIdx;
-		}
-	}
-	BG_TxtMode_Screens[bgMapBaseBlock][0] = 2;
+    if(Residency_Stale(GAME_ASSET_BGTILES))
+    {
+        // dummy BG tile art
+        // the number corresponds to the color idx in the palette
+        char smileyTile[64] __attribute__((aligned(4))) = {
+            55, 55, 55, 55, 55, 55, 55, 55,
+            55, 55, 55, 55, 55, 55, 55, 55,
+            55, 55,  1, 55, 55,  1, 55, 55,
+             1, 55,  1, 55, 55,  1, 55,  1,
+             1, 55, 55, 55, 55, 55, 55,  1,
+            55,  1, 55, 55, 55, 55,  1, 55,
+            55, 55,  1,  1,  1,  1, 55, 55,
+            55, 55, 55, 55, 55, 55, 55, 55,
+        };
+        memcpy32(&tile8_mem[0][2], smileyTile, sizeof(smileyTile) / 4);
+        char blankTile[64] __attribute__((aligned(4))) = {
+            55, 55, 55, 55, 55, 55, 55, 55,
+            55, 55, 55, 55, 55, 55, 55, 55,
+            55, 55, 55, 55, 55, 55, 55, 55,
+            55, 55, 55, 55, 55, 55, 55, 55,
+            55, 55, 55, 55, 55, 55, 55, 55,
+            55, 55, 55, 55, 55, 55, 55, 55,
+            55, 55, 55, 55, 55, 55, 55, 55,
+            55, 55, 55, 55, 55, 55, 55, 55
+        };
+        memcpy32(&tile8_mem[0][1], blankTile, sizeof(blankTile) / 4);
+        Residency_Uploaded(GAME_ASSET_BGTILES, "BG tiles", sizeof(smileyTile) + sizeof(blankTile));
+    }
+
+    if(Residency_Stale(GAME_ASSET_BGMAP))
+    {
+        // Create a basic tilemap
+        BG_TxtMode_Tile blankTileIdx = 1; // first non-zero BG tile
+        *BG_TxtMode_Screens[0] = 0;
+        // fill both screenblocks of the 64x32 map, two entries per word
+        memset32(BG_TxtMode_Screens[bgMapBaseBlock], blankTileIdx | (blankTileIdx << 16), 2 * 1024 / 2);
+        BG_TxtMode_Screens[bgMapBaseBlock][0] = 2;
+        Residency_Uploaded(GAME_ASSET_BGMAP, "BG map", 2 * 1024 * sizeof(BG_TxtMode_Tile));
+    }
+    Residency_End();
 
 #ifdef __DEBUG__
 	// print a debug message, viewable in mGBA
@@ -390,22 +540,33 @@ gameState_GameInit(GameScreenState *state)
 	state->bgHOffsetRate = FP(0, 0x4000);
 
 	// create an obstacle
-    for(u32 i = 0; i < OBSTACLES_MAX; i++)
-    {
-        state->obstacles[i] = (Obstacle){0};
-    }
+    state->obstacles = (ObstacleSet){0};
+    ColliderSet_Clear(&state->colliders);
     state->obstacleIdx = 0;
-    state->obstacles[state->obstacleIdx] = ObstacleCreate(OAM_objs, &state->obstaclePool, &state->randState);
+    Obstacle_Create(&state->obstacles, state->obstacleIdx, &state->objPool, &state->rand);
+    Obstacle_AddColliders(&state->obstacles, state->obstacleIdx, &state->colliders);
 	state->obstacleIdx++;
-
-	return GAMESTATE_TITLESCREEN;
 }
 
 GameStates
 gameState_TitleScreen(GameScreenState *state)
 {
     Vsync();
+    TileStream_Flush();
+    OAM_Commit();
+    // the game itself never submits to the multiplexer, it only runs
+    // when the host runner's -s stress test hands it entries
+    if(Game_MuxEntries) OBJMux_Commit();
+    OBJBUDGET_FRAME();
     UpdateButtonStates(&state->inputs);
+    if(Replay_CheckDue()) Replay_Check(GameScreenState_Checksum(state));
+
+    // SELECT plays back the session so far from the start
+    if(ButtonPressed(&state->inputs, KEYPAD_SEL) && Replay_State.mode != REPLAY_PLAY)
+    {
+        Replay_Stop();
+        if(Replay_Play(GAME_SEED)) return GAMESTATE_GAMESCREENDEINIT;
+    }
 
 	// scroll BG. since the BGxHOFS register is write-only,
 	// the offset needs to be stored in the game state
@@ -413,58 +574,73 @@ gameState_TitleScreen(GameScreenState *state)
     if(state->bgHOffset > FP(511,0)) { state->bgHOffset -= FP(511,0); }
     *BG0HOFS = FP2Int(state->bgHOffset);
 
-	OBJ_ATTR *OAM_objs = (OBJ_ATTR *)OAM_MEM;
-
     // ButtonA_light
-	//BF_SET(&OAM_objs[5].attr2, SPRITE_ButtonA_light_CHARNAME, ATTR2_CHARNAME_LEN, ATTR2_CHARNAME_SHIFT);
+	//BF_SET(&OAM_Touch(state->buttonOAMIdx)->attr2, SPRITE_ButtonA_light_CHARNAME, ATTR2_CHARNAME_LEN, ATTR2_CHARNAME_SHIFT);
 
     // move player
     state->player.velY += state->GravityPerFrame;
     if(state->player.y > 85)
     {
         state->player.velY = Int2FP(-3);
-        xorshift32(&state->randState); // seed the RNG on button press
+        RandRing_Next(&state->rand); // seed the RNG on button press
         Animation_Restart(state->aButtonAnimation);
         Animation_Restart(state->player.anim);
     }
     state->player.y += FP2Int(state->player.velY);
-    Animation_Update(state->player.anim, 1);
+    AnimationBank_UpdateAll();
 
     // udpate the A Button sprite
-    Animation_Update(state->aButtonAnimation, 1);
-    BF_SET(&OAM_objs[5].attr2, state->aButtonAnimation->frames[state->aButtonAnimation->curFrame], ATTR2_CHARNAME_LEN, ATTR2_CHARNAME_SHIFT);
+    BF_SET(&OAM_Touch(state->buttonOAMIdx)->attr2, Animation_CharName(state->aButtonAnimation), ATTR2_CHARNAME_LEN, ATTR2_CHARNAME_SHIFT);
 	
-    // update the player sprite
-    BF_SET(
-        &OAM_objs[state->player.oamIdx].attr2,
-        state->player.anim->frames[state->player.anim->curFrame],
-        ATTR2_CHARNAME_LEN,
-        ATTR2_CHARNAME_SHIFT
-        );
+    // update the player sprite, its tiles go up at the next VBlank
+    TileStream_Show(state->playerTileStream, Animation_CharName(state->player.anim));
     UpdateOBJPos(
-        &OAM_objs[state->player.oamIdx],
+        OAM_Touch(state->player.oamIdx),
         state->player.x,
         WrapY(state->player.y)
         ); 
 
 	if(ButtonPressed(&state->inputs, KEYPAD_A))
 	{
-		BIT_SET(&OAM_objs[5].attr0, ATTR0_DISABLE);
+		BIT_SET(&OAM_Touch(state->buttonOAMIdx)->attr0, ATTR0_DISABLE);
+		state->onTitleScreen = 0;
 		return GAMESTATE_GAMESCREEN;
 	}
 
+    // top up the RNG while there's time left before the next VBlank
+    RandRing_Refill(&state->rand);
+
 	return GAMESTATE_TITLESCREEN;
 }
 
-GameStates
+IWRAM_CODE GameStates
 gameState_GameScreen(GameScreenState *state)
 {
-    char debug_msg[DEBUG_MSG_LEN];
-
-    Vsync();
+    u32 vblanks = Vsync();
+    TileStream_Flush();
+    OAM_Commit();
+    // the game itself never submits to the multiplexer, it only runs
+    // when the host runner's -s stress test hands it entries
+    if(Game_MuxEntries) OBJMux_Commit();
+    OBJBUDGET_FRAME();
+    PROFILE_FRAME();
+
+    PROFILE_BEGIN("input");
     UpdateButtonStates(&state->inputs);
+    if(Replay_CheckDue()) Replay_Check(GameScreenState_Checksum(state));
+    PROFILE_END();
 
-	OBJ_ATTR *OAM_objs = (OBJ_ATTR *)OAM_MEM;
+#ifdef __DEBUG__
+    // the previous frame ran past its VBlank
+    if(vblanks > 1)
+    {
+        char debug_msg[DEBUG_MSG_LEN];
+        snprintf(debug_msg, DEBUG_MSG_LEN, "lag: %ld frame(s) dropped", vblanks - 1);
+        mgba_printf(DEBUG_WARN, debug_msg);
+    }
+#else
+    (void)vblanks; // only the debug build reports lag
+#endif
 
     // scroll the BG
     // BG0HOFS is write-only so we need an extra variable (bgHOffset)
@@ -475,29 +651,26 @@ gameState_GameScreen(GameScreenState *state)
     *BG0HOFS = FP2Int(state->bgHOffset);
 
     // move player
+    PROFILE_BEGIN("player");
     state->player.velY += state->GravityPerFrame;
     if(ButtonPressed(&state->inputs, KEYPAD_A))
     {
         state->player.velY = Int2FP(-3);
-        xorshift32(&state->randState); // seed the RNG on button press
+        RandRing_Next(&state->rand); // seed the RNG on button press
         Animation_Restart(state->player.anim);
     }
     state->player.y += FP2Int(state->player.velY);
-    Animation_Update(state->player.anim, 1);
+    AnimationBank_UpdateAll();
     PlayerCollideBorder(&state->player, &state->screenDim);
 
-    // update the player sprite
-    BF_SET(
-        &OAM_objs[state->player.oamIdx].attr2,
-        state->player.anim->frames[state->player.anim->curFrame],
-        ATTR2_CHARNAME_LEN,
-        ATTR2_CHARNAME_SHIFT
-        );
+    // update the player sprite, its tiles go up at the next VBlank
+    TileStream_Show(state->playerTileStream, Animation_CharName(state->player.anim));
     UpdateOBJPos(
-        &OAM_objs[state->player.oamIdx],
+        OAM_Touch(state->player.oamIdx),
         state->player.x,
         WrapY(state->player.y)
         ); 
+    PROFILE_END();
 
     // check if the player has gone off the btm of the screen
     if(state->player.y + state->player.bounding_box.y > state->screenDim.h)
@@ -506,117 +679,122 @@ gameState_GameScreen(GameScreenState *state)
         return GAMESTATE_GAMEOVER;
     }
 
-    // update the obstacles
+    // update the obstacles. they all move together, so their colliders
+    // are moved as a set
+    PROFILE_BEGIN("obstacles");
+    ColliderSet_Scroll(&state->colliders, 1);
+    ObstacleSet *obstacles = &state->obstacles;
     for(size_t i = 0; i < OBSTACLES_MAX; i++)
     {
-        if(state->obstacles[i].active == 0) continue;
+        if(!Obstacle_Active(obstacles, i)) continue;
 
-        state->obstacles[i].x -= 1;
+        obstacles->x[i] -= 1;
 
         // add to the score if the obstacle has moved past the player
         if(
-            (state->obstacles[i].x + state->obstacles[i].bounding_box_top.w < state->player.x) &&
-            state->obstacles[i].countedScore == 0)
+            (obstacles->x[i] + OBSTACLE_BOX_W < state->player.x) &&
+            !(obstacles->countedScore & (1 << i)))
         {
-            if(state->score < 9999) ++state->score;
-            state->obstacles[i].countedScore = 1;
+            Score_Increment(&state->score);
+            obstacles->countedScore |= 1 << i;
 
-            // redraw the score sprites
-            u32 digit;
-            u32 tmp = state->score;
-            for(i32 i = ARR_LENGTH(state->scoreCounterOAMIdxs) - 1; i > -1; --i)
-            {
-                digit = tmp % 10;
-                tmp /= 10;
-                // the tile idx for the numbers starts at 128
-                // tile idx goes up by 8 for each number
-                BF_SET(
-                    &OAM_objs[state->scoreCounterOAMIdxs[i]].attr2,
-                    SPRITE_Numbers_0_CHARNAME + digit * 8, // TODO: magic number bad
-                    ATTR2_CHARNAME_LEN,
-                    ATTR2_CHARNAME_SHIFT
-                );
-            }
+            // redraw the digits that changed
+            PROFILE_BEGIN("score");
+            Game_DrawScore(state);
+            PROFILE_END();
 
 #ifdef __DEBUG__
-            snprintf(debug_msg, DEBUG_MSG_LEN, "score: %ld", state->score);
+            char debug_msg[DEBUG_MSG_LEN];
+            snprintf(debug_msg, DEBUG_MSG_LEN, "score: %ld", state->score.value);
             mgba_printf(DEBUG_DEBUG, debug_msg);
 #endif
         }
 
         // check if the obstacle has gone out of the game
-        if(state->obstacles[i].x <= -32)
+        if(obstacles->x[i] <= -32)
         {
             // disable the obstacle
-            Obstacle_Clear(&state->obstacles[i]);
-            state->obstacles[i] = (Obstacle){0};
-        }
-
-        // in order to get the obstacle to move off the left side,
-        // the obj must wrap back in from the right side of the map
-        for(i32 j = 0; j < MAX_TILES_LEN; j++)
-        {
-            if(state->obstacles[i].tiles[j].active)
-            {
-                UpdateOBJPos(
-                        &OAM_objs[state->obstacles[i].tiles[j].oamIdx],
-                        WrapX(state->obstacles[i].x),
-                        state->obstacles[i].tiles[j].y
-                        );
-            }
+            Obstacle_Clear(obstacles, i, &state->objPool);
         }
     }
 
-    // check for collisions
-    for(u32 i = 0; i < ARR_LENGTH(state->obstacles); i++)
+    // in order to get the obstacle to move off the left side,
+    // the obj must wrap back in from the right side of the map
+    for(u32 t = 0; t < obstacles->tileCount; t++)
+    {
+        UpdateOBJPos(
+                OAM_Touch(obstacles->tileOAM[t]),
+                WrapX(obstacles->x[obstacles->tileFlags[t] & OBSTACLE_TILE_SLOT_MASK]),
+                obstacles->tileY[t]
+                );
+    }
+    PROFILE_END();
+
+    // check for collisions. obstacles that are past the left edge can't
+    // hit anything anymore
+    PROFILE_BEGIN("collision");
+    ColliderSet_Cull(&state->colliders, 0);
+
+    // the boxes only narrow it down to the obstacles the sprite touches,
+    // the masks decide. (edges are inclusive, w - 1 covers the sprite)
+    Rectangle playerRect = Rectangle_Create(
+            state->player.x,
+            state->player.y,
+            SPRITE_Robo_1_WIDTH - 1,
+            SPRITE_Robo_1_HEIGHT - 1);
+    u32 hits[OBSTACLES_MAX * 2];
+    u32 hitCount = ColliderSet_Query(&state->colliders, &playerRect, hits, ARR_LENGTH(hits));
+    if(hitCount)
     {
-        // create a screen-space rectangle for the player
-        Rectangle playerRect = Rectangle_Create(
-                state->player.x + state->player.bounding_box.x,
-                state->player.y + state->player.bounding_box.y,
-                state->player.bounding_box.w,
-                state->player.bounding_box.h);
-
-        // create screen-space rects for the top and bottom bounding boxes
-        if(state->obstacles[i].active)
+        CollisionMask playerMask = {
+            Player_Mask(&state->player),
+            state->player.x,
+            state->player.y,
+            SPRITE_Robo_1_HEIGHT,
+            0
+        };
+        for(u32 i = 0; i < hitCount; i++)
         {
-            Rectangle obstacleRectTop = Rectangle_Create(
-                    state->obstacles[i].x + state->obstacles[i].bounding_box_top.x,
-                    state->obstacles[i].y + state->obstacles[i].bounding_box_top.y,
-                    state->obstacles[i].bounding_box_top.w,
-                    state->obstacles[i].bounding_box_top.h);
-            Rectangle obstacleRectBtm = Rectangle_Create(
-                    state->obstacles[i].x + state->obstacles[i].bounding_box_btm.x,
-                    state->obstacles[i].y + state->obstacles[i].bounding_box_btm.y,
-                    state->obstacles[i].bounding_box_btm.w,
-                    state->obstacles[i].bounding_box_btm.h);
-
-            if( CheckCollision_RectRect(playerRect, obstacleRectTop) || 
-                    CheckCollision_RectRect(playerRect, obstacleRectBtm)
-              )
+            // the top and bottom boxes of an obstacle come out together
+            if(i > 0 && hits[i] == hits[i - 1]) continue;
+            if(Obstacle_CollideMask(&state->obstacles, hits[i], &playerMask))
             {
 #ifdef __DEBUG__
                 mgba_printf(DEBUG_DEBUG, "GAME OVER");
 #endif
+                PROFILE_END();
                 return GAMESTATE_GAMEOVER;
             }
         }
     }
+    PROFILE_END();
 
     // compare the frameCounter variable. Once it reaches a certain
     // number, spawn a new obstacle
     if(state->frameCounter % 120 == 0)
     {
+        PROFILE_BEGIN("spawn");
 #ifdef __DEBUG__
         mgba_printf(DEBUG_DEBUG, "create new obstacle");
 #endif
-        state->obstacles[state->obstacleIdx] = ObstacleCreate(OAM_objs, &state->obstaclePool, &state->randState);
+        // an obstacle still on screen in this slot gives its OBJs back first
+        if(Obstacle_Active(&state->obstacles, state->obstacleIdx))
+        {
+            Obstacle_Clear(&state->obstacles, state->obstacleIdx, &state->objPool);
+        }
+        if(Obstacle_Create(&state->obstacles, state->obstacleIdx, &state->objPool, &state->rand))
+        {
+            Obstacle_AddColliders(&state->obstacles, state->obstacleIdx, &state->colliders);
+        }
         state->obstacleIdx++;
         if(state->obstacleIdx == OBSTACLES_MAX) { state->obstacleIdx = 0; }
+        PROFILE_END();
     }
 
     state->frameCounter++;
 
+    // top up the RNG while there's time left before the next VBlank
+    RandRing_Refill(&state->rand);
 
     return GAMESTATE_GAMESCREEN;
 }
@@ -632,6 +810,43 @@ gameState_GameOver(GameScreenState *state)
 GameStates
 gameState_GameScreenDeinit(GameScreenState *state)
 {
-	return GAMESTATE_GAMEINIT;
+	return GAMESTATE_TITLESCREEN;
+}
+
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME 16777619u
+
+u32 GameScreenState_Checksum(const GameScreenState *state)
+{
+	u32 fields[12 + OBSTACLES_MAX * 5];
+	u32 n = 0;
+
+	fields[n++] = state->inputs.prev | ((u32)state->inputs.curr << 16);
+	fields[n++] = state->player.x;
+	fields[n++] = state->player.y;
+	fields[n++] = state->player.velX;
+	fields[n++] = state->player.velY;
+	fields[n++] = state->frameCounter;
+	fields[n++] = state->score.value;
+	fields[n++] = state->obstacleIdx;
+	fields[n++] = state->onTitleScreen;
+	fields[n++] = state->bgHOffset;
+	fields[n++] = state->rand.state.a;
+	fields[n++] = state->objPool.count;
+	for(u32 i = 0; i < OBSTACLES_MAX; i++)
+	{
+		fields[n++] = state->obstacles.x[i];
+		fields[n++] = state->obstacles.y[i];
+		fields[n++] = state->obstacles.gapSize[i];
+		fields[n++] = Obstacle_Active(&state->obstacles, i);
+		fields[n++] = (state->obstacles.countedScore >> i) & 1;
+	}
+
+	u32 hash = FNV_OFFSET;
+	for(u32 i = 0; i < n; i++)
+	{
+		hash = (hash ^ fields[i]) * FNV_PRIME;
+	}
+	return hash;
 }
 
@@ -4,12 +4,14 @@
 #include <stdio.h>
 
 #include "gba.h"
+#include "oam.h"
 #include "collision_detection.h"
 #include "fixed.h"
 #include "obj_pool.h"
 #include "random.h"
 #include "bit_control.h"
 #include "animation.h"
+#include "score.h"
 
 #define ARR_LENGTH(arr) (sizeof(arr) / sizeof(arr[0]))
 
@@ -36,64 +38,155 @@ typedef struct Player {
 } __attribute__((aligned (4))) Player;
 
 u16 PlayerCollideBorder(Player *player, ScreenDim *screenDim);
+// mask of the animation frame currently showing
+const u32 *Player_Mask(const Player *player);
 Player Player_Create(u32 oamIdx, u32 x, u32 y, Rectangle bounding_box, fp_t velX, fp_t velY);
 
-void UpdateOBJPos(OBJ_ATTR *obj, int x, int y);
-
-typedef struct ObstacleTile {
-    u32 oamIdx;
-	i32 y;
-	u32 gapSize;
-    u32 active;
-} ObstacleTile;
+IWRAM_CODE void UpdateOBJPos(OBJ_ATTR *obj, int x, int y);
 
 #define OBSTACLES_MAX 4
 #define OBSTACLE_START_X 275
 #define OBSTACLE_TILE_SIZE 32
-//#define MAX_TILES_LEN 6
-#define MAX_TILES_LEN 12
-typedef struct Obstacle {
-	i32 x;
-	u32 y;
-	u32 gapSize;
-    u32 active;
-    u32 countedScore;
-    Rectangle bounding_box_top;
-    Rectangle bounding_box_btm;
-    ObstacleTile tiles[MAX_TILES_LEN];
-} Obstacle;
-Obstacle ObstacleCreate(OBJ_ATTR* OAM_objs, OBJPool* obstaclePool, xorshift32_state* randState);
-void Obstacle_Clear(Obstacle* obstacle);
+// width of an obstacle's boxes
+#define OBSTACLE_BOX_W 24
+// the gap's size is in [OBSTACLE_GAP_MIN, OBSTACLE_GAP_MAX) and its
+// center keeps OBSTACLE_GAP_MARGIN pixels between the gap and the edges
+#define OBSTACLE_GAP_MIN 50
+#define OBSTACLE_GAP_MAX 96
+#define OBSTACLE_GAP_MARGIN 16
+// the gap is at least 50 pixels, so the two columns cover 110 pixels of
+// the screen at most: 3 tiles plus the one each column needs to reach
+// its edge. test/test_obstacles.c checks every gap and center
+#define MAX_TILES_LEN 5
+#define OBSTACLE_TILES_MAX (OBSTACLES_MAX * MAX_TILES_LEN)
+
+// ObstacleSet.tileFlags, the slot of the owning obstacle in the low bits
+#define OBSTACLE_TILE_SLOT_MASK 0x3
+#define OBSTACLE_TILE_END (1 << 2)   // an end piece, the rest are the tiling sprite
+#define OBSTACLE_TILE_FLIPV (1 << 3) // in the bottom column
+
+// The obstacles, one array per field and a bit per slot for the flags.
+// Their tiles are in a dense list, only the live ones, so the per-frame
+// walk doesn't look at empty slots. A cleared slot has all its fields
+// zeroed and its tiles taken out of the list, moving the last ones down
+typedef struct ObstacleSet {
+    i16 x[OBSTACLES_MAX];
+    u8 y[OBSTACLES_MAX];       // gap center
+    u8 gapSize[OBSTACLES_MAX];
+    u8 oamBase[OBSTACLES_MAX]; // the tiles' run of OAM entries starts here
+    u8 active;                 // bit per slot
+    u8 countedScore;           // bit per slot
+    u8 tileCount;
+    i16 tileY[OBSTACLE_TILES_MAX];
+    u8 tileOAM[OBSTACLE_TILES_MAX];
+    u8 tileFlags[OBSTACLE_TILES_MAX];
+} ObstacleSet;
+
+static inline u32 Obstacle_Active(const ObstacleSet *set, u32 slot)
+{
+    return (set->active >> slot) & 1;
+}
+
+// tiles in the columns above and below a gap centered on y, including the
+// end tiles. the division truncates, so each column gets one more to make
+// sure it reaches the edge of the screen
+static inline void Obstacle_ColumnTiles(i32 y, i32 gapSize, i32 *top, i32 *btm)
+{
+    *top = (y - (gapSize / 2)) / OBSTACLE_TILE_SIZE + 1;
+    *btm = (SCREEN_HEIGHT - (y + (gapSize / 2))) / OBSTACLE_TILE_SIZE + 1;
+}
+
+// a new obstacle in `slot` with its OAM OBJs set up. Returns FALSE if the
+// pool had no room for its tiles, the slot is left inactive
+u32 Obstacle_Create(ObstacleSet *set, u32 slot, OBJPool* objPool, RandRing* rand);
+// disable the obstacle's OBJs, give them back to the pool and empty the slot
+void Obstacle_Clear(ObstacleSet *set, u32 slot, OBJPool* objPool);
+// the top and bottom boxes of the obstacle in `slot`, tagged with it
+void Obstacle_AddColliders(const ObstacleSet *set, u32 slot, ColliderSet* colliders);
+// pixel test of `mask` against every tile of the obstacle
+IWRAM_CODE u32 Obstacle_CollideMask(const ObstacleSet *set, u32 slot, const CollisionMask* mask);
 
 void OAM_OBJClear(i32 idx);
 
 
+// every run starts from this, replays (replay.h) depend on it
+#define GAME_SEED 69420
+
+// the top of OAM can be left to the multiplexer (obj_mux.h)
+#define GAME_MUX_ENTRIES 64
+// entries a session hands the multiplexer, taken out of the OBJ pool by
+// GameInit. The game doesn't use the multiplexer: this stays 0, which
+// leaves it off and skips its commit, unless the host runner's -s stress
+// test turns it on
+extern u32 Game_MuxEntries;
+
+// the sprite sheet is loaded up to the robot's second frame, its later
+// frames are streamed into one slot (tile_stream.h)
+#define GAME_RESIDENT_CHARS SPRITE_Robo_2_CHARNAME
+
+// the score is drawn with digit sprites, or on a BG1 HUD with this
+// defined. The HUD sits under all the sprites
+//#define GAME_SCORE_BG
+#define GAME_SCORE_DIGITS 4
+// BG1's map, after BG0's two screenblocks
+#define GAME_HUD_MAPBLOCK 30
+// the HUD's digits in charblock 0, past BG0's tiles
+#define GAME_HUD_TILE 16
+
+// the bottom of OAM is kept for the sprites that last the whole session,
+// so they draw over the obstacles: the score digits (unless the score is
+// on the HUD), the player, then the title screen's A button
+#ifdef GAME_SCORE_BG
+#define GAME_OAM_SCORE_COUNT 0
+#else
+#define GAME_OAM_SCORE_COUNT GAME_SCORE_DIGITS
+#endif
+#define GAME_OAM_SCORE 0
+#define GAME_OAM_PLAYER (GAME_OAM_SCORE + GAME_OAM_SCORE_COUNT)
+#define GAME_OAM_BUTTON (GAME_OAM_PLAYER + 1)
+#define GAME_OAM_FIXED (GAME_OAM_BUTTON + 1)
+
+// what GameInit keeps in VRAM from one session to the next, tracked by
+// residency.h so a restart doesn't upload them again
+typedef enum {
+    GAME_ASSET_BGPAL,
+    GAME_ASSET_OBJPAL,
+    GAME_ASSET_OBJTILES, // the resident part of the sprite sheet
+    GAME_ASSET_BGTILES,
+    GAME_ASSET_BGMAP,
+    GAME_ASSET_HUD,      // the digit tiles and BG1's map, GAME_SCORE_BG only
+    GAME_ASSET_COUNT
+} GameAssets;
+
 typedef struct {
 } SplashScreenState;
 
 typedef struct {
     InputState inputs;
     Player player;
-    OBJPool obstaclePool;
+    OBJPool objPool;
     ScreenDim screenDim;
     u32 frameCounter;
-    u32 score;
-    u32 scoreCounterOAMIdxs[4];
+    Score score;
+    u32 scoreCounterOAMIdxs[GAME_SCORE_DIGITS];
+    u32 buttonOAMIdx;
+    u32 playerTileStream;
     i32 obstacleIdx;
     u32 onTitleScreen;
     fp_t bgHOffset;
     fp_t bgHOffsetRate;
     fp_t GravityPerFrame;
-    xorshift32_state randState;
-    Obstacle obstacles[OBSTACLES_MAX];
+    RandRing rand;
+    ObstacleSet obstacles;
+    ColliderSet colliders;
     Animation *aButtonAnimation;
 } GameScreenState;
 
+// The states main() steps through, see gameStateTable there. The
+// *Init functions are run on the way into a state, the others once per
+// step, returning the state to go to next
 typedef enum {
-    GAMESTATE_SPLASHSCREENINIT,
     GAMESTATE_SPLASHSCREEN,
-    GAMESTATE_SPLASHSCREENDEINIT,
-    GAMESTATE_GAMEINIT,
     GAMESTATE_TITLESCREEN,
     GAMESTATE_GAMESCREEN,
     GAMESTATE_GAMEOVER,
@@ -101,13 +194,20 @@ typedef enum {
     GAMESTATE_COUNT
 } GameStates;
 
-GameStates gameState_SplashScreenInit(SplashScreenState *state);
+void gameState_SplashScreenInit(SplashScreenState *state);
 GameStates gameState_SplashScreen(SplashScreenState *state);
-GameStates gameState_GameInit(GameScreenState *state);
+// sets up a session, the title screen is its first state
+void gameState_GameInit(GameScreenState *state);
 GameStates gameState_TitleScreen(GameScreenState *state);
-GameStates gameState_GameScreen(GameScreenState *state);
+// the per-frame loop runs from IWRAM as ARM code
+IWRAM_CODE GameStates gameState_GameScreen(GameScreenState *state);
 GameStates gameState_GameOver(GameScreenState *state);
+// ends the session, back to the title screen for a new one
 GameStates gameState_GameScreenDeinit(GameScreenState *state);
 
+// FNV-1a over the simulation fields (no pointers or padding), for the
+// replay checkpoints and the host runner
+u32 GameScreenState_Checksum(const GameScreenState *state);
+
 
 #endif
@@ -1,9 +1,21 @@
 #include "gba.h"
 #include "bit_control.h"
+#include "irq.h"
+#include "replay.h"
 
-void Vsync() {
-	while(*VCOUNT_MEM >= 160);  // wait until VDraw
-	while(*VCOUNT_MEM <  160);  // wait until VBlank
+// Rather than spinning on VCOUNT, let the BIOS halt the CPU until the
+// VBlank interrupt comes in. The interrupt counter keeps going even if a
+// frame runs long, so the difference tells us how many VBlanks we missed
+u32 Vsync() {
+	static u32 lastVBlankCount = 0;
+
+	IRQ_VBlankIntrWait();
+
+	u32 vblankCount = IRQ_VBlankCount();
+	u32 elapsed = vblankCount - lastVBlankCount;
+	lastVBlankCount = vblankCount;
+
+	return elapsed;
 }
 
 // The buttons are 0 if pressed, 1 if not pressed
@@ -30,24 +42,10 @@ u16 ButtonDown(InputState *inputs, u16 button) {
 	return (inputs->curr & button) < 1 ? 1 : 0;
 }
 
-// Update the buffered input states
+// Update the buffered input states. This is the only place the game
+// reads KEYINPUT, replays record and substitute it here (replay.h)
 void UpdateButtonStates(InputState *inputs) {
 	inputs->prev = inputs->curr;
-	inputs->curr = *KEYINPUT;
+	inputs->curr = Replay_Input(*KEYINPUT);
 }
 
-
-// Go through all 128 OAM entries and for each of them,
-// zero them out and disable them. This prevents a mess of
-// sprites from appearing at 0,0 on initialization
-void OAM_Init() {
-	OBJ_ATTR *obj = (OBJ_ATTR *)OAM_MEM;
-
-	for(int i = 0; i < 128; i++)
-	{
-		*obj = (OBJ_ATTR){0};
-		BIT_SET(&obj->attr0, ATTR0_DISABLE);
-
-		obj++;
-	}
-}
@@ -4,7 +4,12 @@
 #include <stdint.h>
 
 #ifdef __DEBUG__
+#ifdef __HOST__
+#include <assert.h>
+#define ASSERT(expr) assert(expr)
+#else
 #define ASSERT(expr) if(!(expr)) { *(uint8_t*)0x4000301 = 1; }
+#endif
 #else
 #define ASSERT(expr)
 #endif
@@ -15,28 +20,96 @@ typedef uint16_t u16;
 typedef  int16_t i16;
 typedef uint32_t u32;
 typedef  int32_t i32;
+typedef uint64_t u64;
+typedef  int64_t i64;
 
 #define FALSE 0
 #define TRUE 1
 
+// Memory placement
+// IWRAM_CODE functions are built as ARM code and run from IWRAM's 32-bit,
+// zero wait-state bus instead of the 16-bit cartridge bus. they have to
+// be called through long_call since they're out of BL range of ROM.
+// globals already default to IWRAM, IWRAM_DATA just makes it explicit
+#ifdef __HOST__
+#define IWRAM_CODE
+#define IWRAM_DATA
+#define EWRAM_DATA
+#define EWRAM_BSS
+#else
+#define IWRAM_CODE __attribute__((section(".iwram"), long_call, target("arm"), noinline))
+#define IWRAM_DATA __attribute__((section(".iwram.data")))
+#define EWRAM_DATA __attribute__((section(".ewram")))
+#define EWRAM_BSS  __attribute__((section(".sbss")))
+#endif
+
+// BIOS calls, for inline asm. the comment field of SWI is encoded
+// differently in ARM and Thumb
+#if defined(__thumb__)
+#define SWI(n) "swi " #n
+#else
+#define SWI(n) "swi " #n " << 16"
+#endif
+
+// Memory map
+// the host build (make host) backs each region with a plain array so the
+// same register and memory macros work off-device, see host.c
+#ifdef __HOST__
+extern u16 Host_IO[0x200];
+extern u16 Host_PAL[0x200];
+extern u16 Host_VRAM[0xC000];
+extern u16 Host_OAM[0x200];
+extern u16 Host_MGBA[0x100];
+extern u8  Host_SRAM[0x8000];
+#define MEM_IO   ((uintptr_t)Host_IO)
+#define MEM_PAL  ((uintptr_t)Host_PAL)
+#define MEM_VRAM ((uintptr_t)Host_VRAM)
+#define MEM_OAM  ((uintptr_t)Host_OAM)
+#define MEM_MGBA ((uintptr_t)Host_MGBA)
+#define MEM_SRAM ((uintptr_t)Host_SRAM)
+#else
+#define MEM_IO   0x04000000
+#define MEM_PAL  0x05000000
+#define MEM_VRAM 0x06000000
+#define MEM_OAM  0x07000000
+#define MEM_MGBA 0x04FFF600 // mGBA's debug registers, see mgba.h
+#define MEM_SRAM 0x0E000000
+#endif
+
+// Cartridge SRAM, 32KB on an 8-bit bus: only byte reads and writes work
+#define SRAM_MEM  ((volatile u8 *)MEM_SRAM)
+#define SRAM_SIZE 0x8000
+
 #define RGB(r,g,b) (uint16_t)((r << 0) + (g << 5) + (b << 10))
 
 #define SCREEN_WIDTH 240
 #define SCREEN_HEIGHT 160
 
-#define VCOUNT_MEM   ((volatile uint16_t *)0x04000006)
-#define DISPSTAT_MEM ((volatile uint16_t *)0x04000004)
-#define VRAM_MEM ((uint16_t *)0x06000000)
-#define OAM_MEM  ((uint16_t *)0x07000000)
+#define VCOUNT_MEM   ((volatile uint16_t *)(MEM_IO + 0x0006))
+#define DISPSTAT_MEM ((volatile uint16_t *)(MEM_IO + 0x0004))
 
-#define BGPAL_MEM  ((uint16_t *)0x05000000)
-#define OBJPAL_MEM ((uint16_t *)0x05000200)
+// Display Status, shift amounts
+#define DISPSTAT_VBLANKFLAG 0
+#define DISPSTAT_HBLANKFLAG 1
+#define DISPSTAT_VCOUNTFLAG 2
+#define DISPSTAT_VBLANKIRQ 3
+#define DISPSTAT_HBLANKIRQ 4
+#define DISPSTAT_VCOUNTIRQ 5
+#define DISPSTAT_VCOUNTSETTING 8
+#define DISPSTAT_VCOUNTSETTING_LEN 8
+#define VRAM_MEM ((uint16_t *)MEM_VRAM)
+#define OAM_MEM  ((uint16_t *)MEM_OAM)
 
-void OAM_Init(void);
+#define BGPAL_MEM  ((uint16_t *)MEM_PAL)
+#define OBJPAL_MEM ((uint16_t *)(MEM_PAL + 0x0200))
 
 // Display Control
-#define REG_DISPCNT ((uint16_t *)0x04000000)
-void Vsync();
+#define REG_DISPCNT ((uint16_t *)(MEM_IO + 0x0000))
+
+// Halt until the next VBlank. Returns the number of VBlanks that went by
+// since the previous call, so anything above 1 means frames were dropped.
+// Needs the VBlank interrupt enabled, see irq.h
+u32 Vsync();
 
 // Display Control, shift amounts
 #define DISPCNT_BGMODE_SHIFT 0
@@ -57,10 +130,10 @@ void Vsync();
 
 
 // BG Control Registers
-#define BG0CNT ((u16 *)0x04000008)
-#define BG1CNT ((u16 *)0x0400000A)
-#define BG2CNT ((u16 *)0x0400000C)
-#define BG3CNT ((u16 *)0x0400000E)
+#define BG0CNT ((u16 *)(MEM_IO + 0x0008))
+#define BG1CNT ((u16 *)(MEM_IO + 0x000A))
+#define BG2CNT ((u16 *)(MEM_IO + 0x000C))
+#define BG3CNT ((u16 *)(MEM_IO + 0x000E))
 
 // BG Control Registers, shift amounts
 #define BGXCNT_PRIORITY 0
@@ -73,20 +146,20 @@ void Vsync();
 
 // BG Scrolling Registers
 // each of these is write-only
-#define BG0HOFS ((u16 *)0x04000010)
-#define BG0VOFS ((u16 *)0x04000012)
-#define BG1HOFS ((u16 *)0x04000014)
-#define BG1VOFS ((u16 *)0x04000016)
-#define BG2HOFS ((u16 *)0x04000018)
-#define BG2VOFS ((u16 *)0x0400001A)
-#define BG3HOFS ((u16 *)0x0400001C)
-#define BG3VOFS ((u16 *)0x0400001E)
+#define BG0HOFS ((u16 *)(MEM_IO + 0x0010))
+#define BG0VOFS ((u16 *)(MEM_IO + 0x0012))
+#define BG1HOFS ((u16 *)(MEM_IO + 0x0014))
+#define BG1VOFS ((u16 *)(MEM_IO + 0x0016))
+#define BG2HOFS ((u16 *)(MEM_IO + 0x0018))
+#define BG2VOFS ((u16 *)(MEM_IO + 0x001A))
+#define BG3HOFS ((u16 *)(MEM_IO + 0x001C))
+#define BG3VOFS ((u16 *)(MEM_IO + 0x001E))
 
 // BG map setup
 typedef u16 BG_TxtMode_Tile;
 typedef  u8 BG_RotScale_Tile;
 typedef BG_TxtMode_Tile BG_TxtMode_ScreenBaseBlock[1024];
-#define BG_TxtMode_Screens ((BG_TxtMode_ScreenBaseBlock*)0x06000000)
+#define BG_TxtMode_Screens ((BG_TxtMode_ScreenBaseBlock*)MEM_VRAM)
 
 
 
@@ -100,8 +173,8 @@ typedef struct { u32 data[16]; } TILE8;
 // blocks 4-5 are for OBJ tiles
 typedef TILE4 CHARBLOCK[512];
 typedef TILE8 CHARBLOCK8[256];
-#define tile_mem  ( (CHARBLOCK*)0x06000000)
-#define tile8_mem ((CHARBLOCK8*)0x06000000)
+#define tile_mem  ( (CHARBLOCK*)MEM_VRAM)
+#define tile8_mem ((CHARBLOCK8*)MEM_VRAM)
 
 
 typedef struct {
@@ -111,6 +184,19 @@ typedef struct {
 	u16 fill;
 } __attribute__((aligned(4))) OBJ_ATTR;
 
+// the affine matrices are interleaved with the OBJ attributes,
+// one matrix element in the `fill` field of four consecutive entries
+typedef struct {
+	u16 fill0[3];
+	i16 pa;
+	u16 fill1[3];
+	i16 pb;
+	u16 fill2[3];
+	i16 pc;
+	u16 fill3[3];
+	i16 pd;
+} __attribute__((aligned(4))) OBJ_AFFINE;
+
 // OAM OBJ Control, shift amounts
 #define ATTR0_ROTSCALEFLAG 8
 #define ATTR0_DBLSIZE 9
@@ -118,7 +204,7 @@ typedef struct {
 #define ATTR0_OBJMODE 10
 #define ATTR0_OBJMOSAIC 12
 #define ATTR0_COLORMODE 13
-#define ATTR0_OBJSHAPE 13
+#define ATTR0_OBJSHAPE 14
 
 #define ATTR0_YCOORD_SHIFT 0
 #define ATTR0_YCOORD_MASK 0xFF
@@ -145,7 +231,12 @@ typedef struct {
 
 
 // Keypad
-#define KEYINPUT (volatile u16 *)0x04000130;
+#define KEYINPUT ((volatile u16 *)(MEM_IO + 0x0130))
+
+// Keypad interrupt control
+#define KEYCNT ((volatile u16 *)(MEM_IO + 0x0132))
+#define KEYCNT_IRQ 14
+#define KEYCNT_CONDITION 15 // 0: any of the keys, 1: all of the keys
 
 // Keypad, shift amounts
 #define KEYPAD_A (1 << 0)
@@ -159,6 +250,26 @@ typedef struct {
 #define KEYPAD_RS (1 << 8)
 #define KEYPAD_LS (1 << 9)
 
+// Timers
+// each timer has a 16-bit data register (the counter on read, the
+// reload value on write) followed by its control register
+#define TM0D   ((volatile u16 *)(MEM_IO + 0x0100))
+#define TM0CNT ((volatile u16 *)(MEM_IO + 0x0102))
+#define TM1D   ((volatile u16 *)(MEM_IO + 0x0104))
+#define TM1CNT ((volatile u16 *)(MEM_IO + 0x0106))
+#define TM2D   ((volatile u16 *)(MEM_IO + 0x0108))
+#define TM2CNT ((volatile u16 *)(MEM_IO + 0x010A))
+#define TM3D   ((volatile u16 *)(MEM_IO + 0x010C))
+#define TM3CNT ((volatile u16 *)(MEM_IO + 0x010E))
+#define TMD(n)   (TM0D + (n) * 2)
+#define TMCNT(n) (TM0CNT + (n) * 2)
+
+// Timer Control, shift amounts
+#define TMCNT_PRESCALER 0 // 0: 1 cycle, 1: 64, 2: 256, 3: 1024
+#define TMCNT_CASCADE 2
+#define TMCNT_IRQ 6
+#define TMCNT_ENABLE 7
+
 // Input convenience functions
 typedef struct {
 	u16 prev;
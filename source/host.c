@@ -0,0 +1,100 @@
+#ifdef __HOST__
+
+#include <string.h>
+
+#include "host.h"
+#include "bit_control.h"
+#include "dma.h"
+#include "irq.h"
+
+// memory regions, sized like the hardware ones. the mGBA block covers
+// 0x04FFF600-0x04FFF7FF. SRAM is byte-wide
+u16 Host_IO[0x200] __attribute__((aligned(4)));
+u16 Host_PAL[0x200] __attribute__((aligned(4)));
+u16 Host_VRAM[0xC000] __attribute__((aligned(4)));
+u16 Host_OAM[0x200] __attribute__((aligned(4)));
+u16 Host_MGBA[0x100] __attribute__((aligned(4)));
+u8  Host_SRAM[0x8000] __attribute__((aligned(4)));
+
+u32 Host_FrameCount;
+
+static Host_LineHook hostLineHook;
+static Host_FrameHook hostFrameHook;
+
+void Host_Init(void)
+{
+	memset(Host_IO, 0, sizeof(Host_IO));
+	memset(Host_PAL, 0, sizeof(Host_PAL));
+	memset(Host_VRAM, 0, sizeof(Host_VRAM));
+	memset(Host_OAM, 0, sizeof(Host_OAM));
+	memset(Host_MGBA, 0, sizeof(Host_MGBA));
+	// blank SRAM reads as all ones
+	memset(Host_SRAM, 0xFF, sizeof(Host_SRAM));
+	DMA_HostReset();
+	IRQ_HostReset();
+
+	// keys are active low, nothing held
+	*KEYINPUT = 0x03FF;
+	// park on the last line so the first wait emulates a whole frame
+	*VCOUNT_MEM = HOST_LINES_TOTAL - 1;
+
+	Host_FrameCount = 0;
+	hostLineHook = NULL;
+	hostFrameHook = NULL;
+}
+
+void Host_SetLineHook(Host_LineHook hook)
+{
+	hostLineHook = hook;
+}
+
+void Host_SetFrameHook(Host_FrameHook hook)
+{
+	hostFrameHook = hook;
+}
+
+// One scanline: the VCount match as the line starts, the line itself,
+// then its HBlank. VBlank starts with line 160
+static void Host_Line(u32 line)
+{
+	u16 dispstat = *DISPSTAT_MEM & ~((1 << DISPSTAT_VBLANKFLAG) | (1 << DISPSTAT_HBLANKFLAG) | (1 << DISPSTAT_VCOUNTFLAG));
+	u32 vcountMatch = (dispstat >> DISPSTAT_VCOUNTSETTING) == line;
+
+	// the VBlank flag stays clear on the last line
+	if(line >= HOST_LINES_VISIBLE && line < HOST_LINES_TOTAL - 1) dispstat |= 1 << DISPSTAT_VBLANKFLAG;
+	if(vcountMatch) dispstat |= 1 << DISPSTAT_VCOUNTFLAG;
+	*DISPSTAT_MEM = dispstat;
+	*VCOUNT_MEM = line;
+
+	if(line == HOST_LINES_VISIBLE)
+	{
+		Host_FrameCount++;
+		DMA_HostTrigger(DMA_TIMING_VBLANK);
+		if(dispstat & (1 << DISPSTAT_VBLANKIRQ)) IRQ_HostRaise(IRQ_MASK(IRQ_VBLANK));
+	}
+	if(vcountMatch && (dispstat & (1 << DISPSTAT_VCOUNTIRQ)))
+	{
+		IRQ_HostRaise(IRQ_MASK(IRQ_VCOUNT));
+	}
+
+	if(line < HOST_LINES_VISIBLE && hostLineHook) hostLineHook(line);
+
+	BIT_SET(DISPSTAT_MEM, DISPSTAT_HBLANKFLAG);
+	// HBlank DMA doesn't run during VBlank, the interrupt does
+	if(line < HOST_LINES_VISIBLE) DMA_HostTrigger(DMA_TIMING_HBLANK);
+	if(*DISPSTAT_MEM & (1 << DISPSTAT_HBLANKIRQ)) IRQ_HostRaise(IRQ_MASK(IRQ_HBLANK));
+}
+
+void Host_WaitVBlank(void)
+{
+	u32 line = *VCOUNT_MEM;
+	do
+	{
+		line = (line + 1 == HOST_LINES_TOTAL) ? 0 : line + 1;
+		Host_Line(line);
+	} while(line != HOST_LINES_VISIBLE);
+
+	if(hostFrameHook) hostFrameHook();
+}
+
+#endif
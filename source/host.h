@@ -0,0 +1,38 @@
+#ifndef __HOST_H__
+#define __HOST_H__
+
+// Native (Linux) platform layer, only built with `make host`.
+// The register and memory macros in gba.h point at the arrays in host.c,
+// and the display is emulated one scanline at a time so blank-timed DMA
+// and the display interrupts happen in the same order as on hardware
+
+#ifdef __HOST__
+
+#include "gba.h"
+
+#define HOST_LINES_VISIBLE SCREEN_HEIGHT
+#define HOST_LINES_TOTAL 228
+
+// Called for every visible line before its HBlank, with VCOUNT already
+// set. Anything mid-frame code wrote to OAM/VRAM is visible here
+typedef void (*Host_LineHook)(u32 line);
+
+// Called at the start of every VBlank, after the VBlank interrupt and
+// DMA have run and before the game's Vsync() returns
+typedef void (*Host_FrameHook)(void);
+
+// Frames (VBlanks) emulated since Host_Init
+extern u32 Host_FrameCount;
+
+// Clear the emulated memory and registers
+void Host_Init(void);
+
+// Run scanlines until the start of the next VBlank
+void Host_WaitVBlank(void);
+
+void Host_SetLineHook(Host_LineHook hook);
+void Host_SetFrameHook(Host_FrameHook hook);
+
+#endif
+
+#endif
@@ -0,0 +1,167 @@
+#include "irq.h"
+#include "bit_control.h"
+
+#ifdef __HOST__
+#include "host.h"
+
+volatile u16 IRQ_HostIFBios;
+volatile IRQ_Handler IRQ_HostISR;
+
+// IF is write-one-to-clear on hardware, a plain array needs the clear
+#define IRQ_ACK(mask) (*REG_IF &= (u16)~(mask))
+#else
+#define IRQ_ACK(mask) (*REG_IF = (mask))
+#endif
+
+static IRQ_Handler irqHandlers[IRQ_COUNT];
+static volatile u32 irqVBlankCount;
+
+// the BIOS jumps to the handler in ARM state. keeping it in IWRAM means
+// it doesn't wait on the cartridge bus while the game is halted
+IWRAM_CODE void IRQ_Dispatch(void)
+{
+	u32 fired = *REG_IE & *REG_IF;
+
+	// acknowledge everything up front, both in IF and the BIOS copy
+	IRQ_ACK(fired);
+	*REG_IFBIOS |= fired;
+
+	if(fired & IRQ_MASK(IRQ_VBLANK)) irqVBlankCount++;
+
+	for(u32 src = 0; fired; src++, fired >>= 1)
+	{
+		if((fired & 1) && irqHandlers[src])
+		{
+			irqHandlers[src]();
+		}
+	}
+}
+
+void IRQ_Init(void)
+{
+	*REG_IME = 0;
+	for(u32 i = 0; i < IRQ_COUNT; i++)
+	{
+		irqHandlers[i] = 0;
+	}
+	irqVBlankCount = 0;
+
+	*REG_ISR_MAIN = IRQ_Dispatch;
+	*REG_IE = 0;
+	IRQ_ACK(0xFFFF);
+	*REG_IME = 1;
+}
+
+void IRQ_SetHandler(IRQ_Source src, IRQ_Handler handler)
+{
+	ASSERT(src < IRQ_COUNT);
+	irqHandlers[src] = handler;
+}
+
+void IRQ_Enable(IRQ_Source src, IRQ_Handler handler)
+{
+	ASSERT(src < IRQ_COUNT);
+
+	// don't let the dispatcher run while the table and IE disagree
+	u16 ime = *REG_IME;
+	*REG_IME = 0;
+
+	irqHandlers[src] = handler;
+
+	switch(src)
+	{
+		case IRQ_VBLANK: BIT_SET(DISPSTAT_MEM, DISPSTAT_VBLANKIRQ); break;
+		case IRQ_HBLANK: BIT_SET(DISPSTAT_MEM, DISPSTAT_HBLANKIRQ); break;
+		case IRQ_VCOUNT: BIT_SET(DISPSTAT_MEM, DISPSTAT_VCOUNTIRQ); break;
+		case IRQ_TIMER0:
+		case IRQ_TIMER1:
+		case IRQ_TIMER2:
+		case IRQ_TIMER3: BIT_SET(TMCNT(src - IRQ_TIMER0), TMCNT_IRQ); break;
+		case IRQ_KEYPAD: BIT_SET(KEYCNT, KEYCNT_IRQ); break;
+		default: break;
+	}
+
+	*REG_IE |= IRQ_MASK(src);
+	*REG_IME = ime;
+}
+
+void IRQ_Disable(IRQ_Source src)
+{
+	ASSERT(src < IRQ_COUNT);
+
+	u16 ime = *REG_IME;
+	*REG_IME = 0;
+
+	switch(src)
+	{
+		case IRQ_VBLANK: BIT_CLEAR(DISPSTAT_MEM, DISPSTAT_VBLANKIRQ); break;
+		case IRQ_HBLANK: BIT_CLEAR(DISPSTAT_MEM, DISPSTAT_HBLANKIRQ); break;
+		case IRQ_VCOUNT: BIT_CLEAR(DISPSTAT_MEM, DISPSTAT_VCOUNTIRQ); break;
+		case IRQ_TIMER0:
+		case IRQ_TIMER1:
+		case IRQ_TIMER2:
+		case IRQ_TIMER3: BIT_CLEAR(TMCNT(src - IRQ_TIMER0), TMCNT_IRQ); break;
+		case IRQ_KEYPAD: BIT_CLEAR(KEYCNT, KEYCNT_IRQ); break;
+		default: break;
+	}
+
+	*REG_IE &= ~IRQ_MASK(src);
+	irqHandlers[src] = 0;
+	*REG_IME = ime;
+}
+
+void IRQ_SetVCount(u32 line)
+{
+	BF_SET(DISPSTAT_MEM, line, DISPSTAT_VCOUNTSETTING_LEN, DISPSTAT_VCOUNTSETTING);
+}
+
+void IRQ_SetKeypad(u16 keys, u32 requireAll)
+{
+	u16 keycnt = *KEYCNT & (1 << KEYCNT_IRQ);
+	keycnt |= keys & 0x3FF;
+	if(requireAll) keycnt |= 1 << KEYCNT_CONDITION;
+	*KEYCNT = keycnt;
+}
+
+u32 IRQ_VBlankCount(void)
+{
+	return irqVBlankCount;
+}
+
+#ifdef __HOST__
+void IRQ_VBlankIntrWait(void)
+{
+	// run the emulated display up to the start of the next VBlank
+	Host_WaitVBlank();
+}
+
+void IRQ_HostRaise(u16 mask)
+{
+	*REG_IF |= mask;
+	if(*REG_IME && (*REG_IE & *REG_IF) && *REG_ISR_MAIN)
+	{
+		(*REG_ISR_MAIN)();
+	}
+}
+
+void IRQ_HostReset(void)
+{
+	*REG_IE = 0;
+	*REG_IF = 0;
+	*REG_IME = 0;
+	IRQ_HostIFBios = 0;
+	IRQ_HostISR = 0;
+	irqVBlankCount = 0;
+	for(u32 i = 0; i < IRQ_COUNT; i++)
+	{
+		irqHandlers[i] = 0;
+	}
+}
+#else
+void IRQ_VBlankIntrWait(void)
+{
+	// SWI 0x05, VBlankIntrWait. it takes no arguments and may clobber
+	// r0-r3
+	__asm__ volatile(SWI(0x05) ::: "r0", "r1", "r2", "r3", "memory");
+}
+#endif
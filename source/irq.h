@@ -0,0 +1,76 @@
+#ifndef __IRQ_H__
+#define __IRQ_H__
+
+#include "gba.h"
+
+// Interrupt sources, in the order of their IE/IF bits
+typedef enum {
+	IRQ_VBLANK,
+	IRQ_HBLANK,
+	IRQ_VCOUNT,
+	IRQ_TIMER0,
+	IRQ_TIMER1,
+	IRQ_TIMER2,
+	IRQ_TIMER3,
+	IRQ_SERIAL,
+	IRQ_DMA0,
+	IRQ_DMA1,
+	IRQ_DMA2,
+	IRQ_DMA3,
+	IRQ_KEYPAD,
+	IRQ_GAMEPAK,
+	IRQ_COUNT
+} IRQ_Source;
+
+#define IRQ_MASK(src) (1 << (src))
+
+typedef void (*IRQ_Handler)(void);
+
+#define REG_IE       ((volatile u16 *)(MEM_IO + 0x0200))
+#define REG_IF       ((volatile u16 *)(MEM_IO + 0x0202))
+#define REG_IME      ((volatile u16 *)(MEM_IO + 0x0208))
+
+// the BIOS keeps its own copy of IF for the IntrWait calls,
+// the handler needs to acknowledge there too
+#ifdef __HOST__
+// these sit at the top of IWRAM, the handler address doesn't fit
+// in 32 bits on the host so they're variables of their own
+extern volatile u16 IRQ_HostIFBios;
+extern volatile IRQ_Handler IRQ_HostISR;
+#define REG_IFBIOS   (&IRQ_HostIFBios)
+#define REG_ISR_MAIN (&IRQ_HostISR)
+#else
+#define REG_IFBIOS   ((volatile u16 *)0x03007FF8)
+#define REG_ISR_MAIN ((volatile IRQ_Handler *)0x03007FFC)
+#endif
+
+// Install the dispatcher and turn on the master enable.
+// Nothing fires until a source is enabled with IRQ_Enable
+void IRQ_Init(void);
+
+// Enable a source in IE and in its own control register (DISPSTAT, TMxCNT
+// or KEYCNT). The handler may be NULL, in which case the interrupt is only
+// acknowledged (and counted, for VBlank)
+void IRQ_Enable(IRQ_Source src, IRQ_Handler handler);
+void IRQ_Disable(IRQ_Source src);
+void IRQ_SetHandler(IRQ_Source src, IRQ_Handler handler);
+
+// Line that raises the VCount interrupt
+void IRQ_SetVCount(u32 line);
+// Keys that raise the keypad interrupt, either when any or all of them are held
+void IRQ_SetKeypad(u16 keys, u32 requireAll);
+
+// Number of VBlank interrupts since IRQ_Init
+u32 IRQ_VBlankCount(void);
+
+// Halt in the BIOS until a new VBlank interrupt has been handled
+void IRQ_VBlankIntrWait(void);
+
+#ifdef __HOST__
+// Flag the given sources in IF and run the dispatcher like the
+// hardware would if they're enabled
+void IRQ_HostRaise(u16 mask);
+void IRQ_HostReset(void);
+#endif
+
+#endif
@@ -1,7 +1,7 @@
 #include <stdint.h>
 #include <string.h>
 #include <stdio.h>
-#include <stdlib.h>
+#include <stddef.h>
 
 #include "gba.h"
 #include "mgba.h"
@@ -10,56 +10,91 @@
 #include "random.h"
 #include "collision_detection.h"
 #include "game_states.h"
+#include "irq.h"
+#include "mem.h"
+#include "profile.h"
+#include "runner.h"
 
+// Only one state's data is live at a time, so they share one static
+// block: nothing is allocated when a state is entered and nothing can be
+// left behind on the heap when it's left
+typedef union {
+    SplashScreenState splash;
+    GameScreenState game;
+} GameStateStorage;
 
+static GameStateStorage gameStateStorage;
+
+// enter runs on the way into a state and exit on the way out, either may
+// be NULL. update runs once per step and returns the next state
+typedef struct {
+    void (*enter)(void);
+    GameStates (*update)(void);
+    void (*exit)(void);
+} GameStateDef;
+
+static void splashScreenEnter(void) { gameState_SplashScreenInit(&gameStateStorage.splash); }
+static GameStates splashScreenUpdate(void) { return gameState_SplashScreen(&gameStateStorage.splash); }
+
+// every session starts on the title screen, so that's where it's set up
+static void titleScreenEnter(void)
+{
+    gameState_GameInit(&gameStateStorage.game);
+    Mem_HeapCheck();
+}
+static GameStates titleScreenUpdate(void) { return gameState_TitleScreen(&gameStateStorage.game); }
+static GameStates gameScreenUpdate(void) { return gameState_GameScreen(&gameStateStorage.game); }
+static GameStates gameOverUpdate(void) { return gameState_GameOver(&gameStateStorage.game); }
+static GameStates gameScreenDeinitUpdate(void) { return gameState_GameScreenDeinit(&gameStateStorage.game); }
+
+static const GameStateDef gameStateTable[GAMESTATE_COUNT] = {
+    [GAMESTATE_SPLASHSCREEN]     = { splashScreenEnter, splashScreenUpdate,     NULL },
+    [GAMESTATE_TITLESCREEN]      = { titleScreenEnter,  titleScreenUpdate,      NULL },
+    [GAMESTATE_GAMESCREEN]       = { NULL,              gameScreenUpdate,       NULL },
+    [GAMESTATE_GAMEOVER]         = { NULL,              gameOverUpdate,         NULL },
+    [GAMESTATE_GAMESCREENDEINIT] = { NULL,              gameScreenDeinitUpdate, NULL },
+};
+
+#ifdef __HOST__
+int main(int argc, char **argv)
+#else
 int main(void)
+#endif
 {
 
+#ifdef __HOST__
+    Runner_Init(argc, argv);
+#endif
+
 #ifdef __DEBUG__
 	mgba_open();
+	Mem_SelfTest();
 #endif
 
-    // pointers for the different game states
-    GameScreenState *gameScreenState;
-    SplashScreenState *splashScreenState;
+    // frame sync sleeps on the VBlank interrupt (see Vsync)
+    IRQ_Init();
+    IRQ_Enable(IRQ_VBLANK, NULL);
 
-    GameStates gameState = GAMESTATE_SPLASHSCREENINIT;
+    // claims timers 2 and 3 when profiling is compiled in
+    PROFILE_INIT();
+
+    GameStates gameState = GAMESTATE_SPLASHSCREEN;
+    gameStateTable[gameState].enter();
     while(1)
     {
-        switch(gameState)
+        ASSERT(gameState < GAMESTATE_COUNT);
+        GameStates next = gameStateTable[gameState].update();
+        if(next != gameState)
         {
-            case GAMESTATE_SPLASHSCREENINIT:
-                splashScreenState = (SplashScreenState *)malloc(sizeof(SplashScreenState));
-                gameState = gameState_SplashScreenInit(splashScreenState);
-                break;
-            case GAMESTATE_SPLASHSCREEN:
-                gameState = gameState_SplashScreen(splashScreenState);
-                break;
-            case GAMESTATE_SPLASHSCREENDEINIT:
-                free(splashScreenState);
-                gameState = GAMESTATE_GAMEINIT;
-                break;
-            case GAMESTATE_GAMEINIT:
-                gameScreenState = (GameScreenState *)malloc(sizeof(GameScreenState));
-                gameState = gameState_GameInit(gameScreenState);
-                break;
-            case GAMESTATE_TITLESCREEN:
-                gameState = gameState_TitleScreen(gameScreenState);
-                break;
-            case GAMESTATE_GAMESCREEN:
-                gameState = gameState_GameScreen(gameScreenState);
-                break;
-            case GAMESTATE_GAMEOVER:
-                gameState = gameState_GameOver(gameScreenState);
-                break;
-            case GAMESTATE_GAMESCREENDEINIT:
-                gameState = gameState_GameScreenDeinit(gameScreenState);
-                free(gameScreenState);
-                break;
-            default:
-                ASSERT(0);
-                break;
+            ASSERT(next < GAMESTATE_COUNT);
+            if(gameStateTable[gameState].exit) gameStateTable[gameState].exit();
+            if(gameStateTable[next].enter) gameStateTable[next].enter();
+            gameState = next;
         }
+
+#ifdef __HOST__
+        Runner_GameState(gameState, &gameStateStorage.game);
+#endif
     }
 
     /* TODO: animation controller
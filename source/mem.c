@@ -0,0 +1,196 @@
+#include <stddef.h>
+#include <stdio.h>
+
+#include "mem.h"
+#include "mgba.h"
+
+#ifdef __HOST__
+// C versions of the routines in mem_arm.s
+
+void memcpy16(void *dst, const void *src, u32 hwcount)
+{
+	u16 *d = dst;
+	const u16 *s = src;
+	while(hwcount--) *d++ = *s++;
+}
+
+void memcpy32(void *dst, const void *src, u32 wcount)
+{
+	u32 *d = dst;
+	const u32 *s = src;
+	while(wcount--) *d++ = *s++;
+}
+
+void memset32(void *dst, u32 fill, u32 wcount)
+{
+	u32 *d = dst;
+	while(wcount--) *d++ = fill;
+}
+
+void CpuSet(const void *src, void *dst, u32 mode)
+{
+	u32 count = mode & CPUSET_COUNT_MASK;
+
+	if(mode & CPUSET_32BIT)
+	{
+		if(mode & CPUSET_FILL) memset32(dst, *(const u32 *)src, count);
+		else                   memcpy32(dst, src, count);
+	}
+	else
+	{
+		u16 *d = dst;
+		const u16 *s = src;
+		if(mode & CPUSET_FILL) while(count--) *d++ = *s;
+		else                   memcpy16(dst, src, count);
+	}
+}
+
+void CpuFastSet(const void *src, void *dst, u32 mode)
+{
+	// always 32-bit, in blocks of 8 words
+	u32 count = ((mode & CPUSET_COUNT_MASK) + 7) & ~7;
+
+	if(mode & CPUSET_FILL) memset32(dst, *(const u32 *)src, count);
+	else                   memcpy32(dst, src, count);
+}
+#else
+void CpuSet(const void *src, void *dst, u32 mode)
+{
+	register const void *r0 __asm__("r0") = src;
+	register void *r1 __asm__("r1") = dst;
+	register u32 r2 __asm__("r2") = mode;
+	__asm__ volatile(SWI(0x0B) : "+r"(r0), "+r"(r1), "+r"(r2) :: "r3", "memory");
+}
+
+void CpuFastSet(const void *src, void *dst, u32 mode)
+{
+	register const void *r0 __asm__("r0") = src;
+	register void *r1 __asm__("r1") = dst;
+	register u32 r2 __asm__("r2") = mode;
+	__asm__ volatile(SWI(0x0C) : "+r"(r0), "+r"(r1), "+r"(r2) :: "r3", "memory");
+}
+#endif
+
+#ifdef __DEBUG__
+
+// room for the longest run at the furthest offset, with a guard word on
+// each side
+#define MEM_TEST_WORDS (MEM_TEST_COUNT + 4)
+
+static void Mem_TestFill(u32 *buf, u32 seed)
+{
+	for(u32 i = 0; i < MEM_TEST_WORDS; i++) buf[i] = (i + seed) * 0x9E3779B9u;
+}
+
+static u32 Mem_TestSame(const u32 *a, const u32 *b)
+{
+	for(u32 i = 0; i < MEM_TEST_WORDS; i++)
+	{
+		if(a[i] != b[i]) return FALSE;
+	}
+	return TRUE;
+}
+
+u32 Mem_SelfTest(void)
+{
+	u32 src[MEM_TEST_WORDS], dst[MEM_TEST_WORDS], expect[MEM_TEST_WORDS];
+	u32 runs = 0, failures = 0;
+
+	for(u32 n = 0; n <= MEM_TEST_COUNT; n++)
+	{
+		// dst and src a word in, or a halfword past that
+		for(u32 d = 0; d < 4; d += 2)
+		{
+			for(u32 s = 0; s < 4; s += 2)
+			{
+				Mem_TestFill(src, n);
+				Mem_TestFill(dst, n + 100);
+				Mem_TestFill(expect, n + 100);
+				u16 *e = (u16 *)((u8 *)expect + 4 + d);
+				const u16 *from = (const u16 *)((u8 *)src + 4 + s);
+				for(u32 i = 0; i < n; i++) e[i] = from[i];
+
+				memcpy16((u8 *)dst + 4 + d, from, n);
+				runs++;
+				if(!Mem_TestSame(dst, expect)) failures++;
+			}
+
+			// the word routines only take word-aligned pointers
+			if(d) continue;
+			for(u32 s = 0; s < 8; s += 4)
+			{
+				Mem_TestFill(src, n);
+				Mem_TestFill(dst, n + 100);
+				Mem_TestFill(expect, n + 100);
+				for(u32 i = 0; i < n; i++) expect[1 + i] = src[1 + s / 4 + i];
+
+				memcpy32(dst + 1, src + 1 + s / 4, n);
+				runs++;
+				if(!Mem_TestSame(dst, expect)) failures++;
+			}
+
+			Mem_TestFill(dst, n + 100);
+			Mem_TestFill(expect, n + 100);
+			for(u32 i = 0; i < n; i++) expect[1 + i] = 0xA5C3F00F;
+
+			memset32(dst + 1, 0xA5C3F00F, n);
+			runs++;
+			if(!Mem_TestSame(dst, expect)) failures++;
+		}
+	}
+
+	char debug_msg[DEBUG_MSG_LEN];
+	snprintf(debug_msg, DEBUG_MSG_LEN, "mem: self test, %ld runs, %ld failed", runs, failures);
+	mgba_printf(failures ? DEBUG_ERROR : DEBUG_INFO, debug_msg);
+	return failures;
+}
+
+#endif
+
+#if defined(__DEBUG__) || defined(__HOST__)
+
+extern void *sbrk(ptrdiff_t increment);
+
+static u8 *heapBaseline;
+static u32 heapGrowth;
+static u32 heapChecks;
+
+void *Mem_HeapTop(void)
+{
+	return sbrk(0);
+}
+
+void Mem_HeapCheck(void)
+{
+	u8 *top = Mem_HeapTop();
+
+	if(++heapChecks <= 2)
+	{
+		heapBaseline = top;
+		return;
+	}
+
+	u32 growth = top > heapBaseline ? (u32)(top - heapBaseline) : 0;
+#ifdef __DEBUG__
+	if(growth > heapGrowth)
+	{
+		char debug_msg[DEBUG_MSG_LEN];
+		snprintf(debug_msg, DEBUG_MSG_LEN, "Heap: grown by %ld bytes after %ld sessions", growth, heapChecks - 2);
+		mgba_printf(DEBUG_WARN, debug_msg);
+	}
+	ASSERT(growth == 0);
+#endif
+	heapGrowth = growth;
+}
+
+u32 Mem_HeapGrowth(void)
+{
+	return heapGrowth;
+}
+
+u32 Mem_HeapChecks(void)
+{
+	return heapChecks;
+}
+
+#endif
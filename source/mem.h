@@ -0,0 +1,50 @@
+#ifndef __MEM_H__
+#define __MEM_H__
+
+#include "gba.h"
+
+// Word-aligned copy and fill routines for small and mid-size buffers,
+// where setting up a DMA transfer costs more than the transfer itself.
+// The GBA versions are ARM code in IWRAM (mem_arm.s) moving 8 registers
+// per ldmia/stmia. Counts are in units, not bytes: halfwords for
+// memcpy16, words for memcpy32/memset32
+IWRAM_CODE void memcpy16(void *dst, const void *src, u32 hwcount);
+IWRAM_CODE void memcpy32(void *dst, const void *src, u32 wcount);
+IWRAM_CODE void memset32(void *dst, u32 fill, u32 wcount);
+
+// BIOS copy/fill calls (SWI 0x0B and 0x0C)
+// CpuSet moves `count` halfwords or words, CpuFastSet moves words in
+// blocks of 8, rounding the count up
+#define CPUSET_COUNT_MASK 0x1FFFFF
+#define CPUSET_FILL (1 << 24)
+#define CPUSET_32BIT (1 << 26)
+
+void CpuSet(const void *src, void *dst, u32 mode);
+void CpuFastSet(const void *src, void *dst, u32 mode);
+
+// Debug builds check memcpy16, memcpy32 and memset32 against plain C
+// loops at boot, for every alignment they take and counts from 0 to
+// MEM_TEST_COUNT units, and log the result to mgba. Returns the number
+// of failed runs. Compiled out otherwise
+#define MEM_TEST_COUNT 40
+#ifdef __DEBUG__
+u32 Mem_SelfTest(void);
+#else
+#define Mem_SelfTest() 0
+#endif
+
+// Heap leak check for debug and host builds. Mem_HeapCheck() is called as
+// each session starts; the heap top at the second one is the baseline
+// (the first session may still pull in stdio's buffers) and any session
+// starting with the heap above it warns. Compiled out otherwise
+#if defined(__DEBUG__) || defined(__HOST__)
+void *Mem_HeapTop(void);
+void Mem_HeapCheck(void);
+// bytes the heap has grown by since the baseline, at the last check
+u32 Mem_HeapGrowth(void);
+u32 Mem_HeapChecks(void);
+#else
+#define Mem_HeapCheck()
+#endif
+
+#endif
@@ -0,0 +1,99 @@
+@ Word-aligned copy/fill routines, see mem.h
+@ ARM code, placed in IWRAM so the ldmia/stmia bursts run from the
+@ 32-bit zero wait-state bus. Unified syntax, so LLVM's assembler takes
+@ it as well as GNU as
+
+	.section .iwram, "ax", %progbits
+	.syntax unified
+	.arm
+	.align 2
+
+@ void memcpy32(void *dst, const void *src, u32 wcount)
+@ leaves r0/r1 pointing past the copied data, memcpy16 relies on that
+	.global memcpy32
+	.type memcpy32, %function
+memcpy32:
+	push    {r4-r10}
+	movs    r12, r2, lsr #3         @ 8-word blocks
+	beq     .Lcpy32_words
+.Lcpy32_blocks:
+	ldmia   r1!, {r3-r10}
+	stmia   r0!, {r3-r10}
+	subs    r12, r12, #1
+	bne     .Lcpy32_blocks
+.Lcpy32_words:
+	ands    r2, r2, #7              @ leftover words
+	beq     .Lcpy32_done
+.Lcpy32_word:
+	ldr     r3, [r1], #4
+	str     r3, [r0], #4
+	subs    r2, r2, #1
+	bne     .Lcpy32_word
+.Lcpy32_done:
+	pop     {r4-r10}
+	bx      lr
+	.size memcpy32, .-memcpy32
+
+@ void memset32(void *dst, u32 fill, u32 wcount)
+	.global memset32
+	.type memset32, %function
+memset32:
+	push    {r4-r9}
+	mov     r3, r1
+	mov     r4, r1
+	mov     r5, r1
+	mov     r6, r1
+	mov     r7, r1
+	mov     r8, r1
+	mov     r9, r1
+	movs    r12, r2, lsr #3         @ 8-word blocks
+	beq     .Lset32_words
+.Lset32_blocks:
+	stmia   r0!, {r1, r3-r9}
+	subs    r12, r12, #1
+	bne     .Lset32_blocks
+.Lset32_words:
+	ands    r2, r2, #7              @ leftover words
+	beq     .Lset32_done
+.Lset32_word:
+	str     r1, [r0], #4
+	subs    r2, r2, #1
+	bne     .Lset32_word
+.Lset32_done:
+	pop     {r4-r9}
+	bx      lr
+	.size memset32, .-memset32
+
+@ void memcpy16(void *dst, const void *src, u32 hwcount)
+@ when src and dst share word alignment the bulk goes through memcpy32,
+@ otherwise it falls back to a halfword loop
+	.global memcpy16
+	.type memcpy16, %function
+memcpy16:
+	cmp     r2, #0
+	bxeq    lr
+	eor     r3, r0, r1
+	tst     r3, #2
+	bne     .Lcpy16_halves
+	tst     r0, #2                  @ leading halfword to reach word alignment
+	beq     .Lcpy16_aligned
+	ldrh    r3, [r1], #2
+	strh    r3, [r0], #2
+	subs    r2, r2, #1
+	bxeq    lr
+.Lcpy16_aligned:
+	push    {r2, lr}
+	mov     r2, r2, lsr #1
+	bl      memcpy32
+	pop     {r2, lr}
+	tst     r2, #1                  @ trailing halfword
+	ldrhne  r3, [r1]
+	strhne  r3, [r0]
+	bx      lr
+.Lcpy16_halves:
+	ldrh    r3, [r1], #2
+	strh    r3, [r0], #2
+	subs    r2, r2, #1
+	bne     .Lcpy16_halves
+	bx      lr
+	.size memcpy16, .-memcpy16
@@ -1,4 +1,7 @@
 #include <string.h>
+#ifdef __HOST__
+#include <stdio.h>
+#endif
 #include "gba.h"
 #include "mgba.h"
 
@@ -12,7 +15,24 @@ inline void mgba_close() {
 	*REG_DEBUG_ENABLE = 0;
 }
 
+#ifdef __HOST__
+// same register writes, then echo the message to stderr since there's
+// no emulator log to read it from. strncpy because callers pass string
+// literals shorter than DEBUG_MSG_LEN
+inline void mgba_printf(u32 level, char *str) {
+	static const char *levels[] = { "FATAL", "ERROR", "WARN", "INFO", "DEBUG" };
+
+	strncpy(REG_DEBUG_STRING, str, DEBUG_MSG_LEN - 1);
+	*REG_DEBUG_FLAGS = (level & 0x7) | 0x100;
+
+	if(*REG_DEBUG_ENABLE == 0xC0DE)
+	{
+		fprintf(stderr, "[%s] %s\n", levels[(level & 0x7) % 5], REG_DEBUG_STRING);
+	}
+}
+#else
 inline void mgba_printf(u32 level, char *str) {
 	memcpy(REG_DEBUG_STRING, str, DEBUG_MSG_LEN);
 	*REG_DEBUG_FLAGS = (level & 0x7) | 0x100;
 }
+#endif
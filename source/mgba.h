@@ -9,9 +9,10 @@
 
 // mGBA Debug Defines
 
-#define REG_DEBUG_ENABLE (volatile u16 *)0x04FFF780
-#define REG_DEBUG_FLAGS  (volatile u16 *)0x04FFF700
-#define REG_DEBUG_STRING         (char *)0x04FFF600
+// offsets from MEM_MGBA (0x04FFF600), see gba.h
+#define REG_DEBUG_ENABLE (volatile u16 *)(MEM_MGBA + 0x180)
+#define REG_DEBUG_FLAGS  (volatile u16 *)(MEM_MGBA + 0x100)
+#define REG_DEBUG_STRING         (char *)(MEM_MGBA + 0x000)
 
 #define DEBUG_FATAL 0
 #define DEBUG_ERROR 1
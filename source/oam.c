@@ -0,0 +1,135 @@
+#include "oam.h"
+#include "bit_control.h"
+#include "dma.h"
+#include "mem.h"
+
+OBJ_ATTR OAM_Shadow[OAM_COUNT] __attribute__((aligned(4)));
+u32 OAM_DirtyBits[OAM_COUNT / 32];
+
+static OAM_CommitStats oamStats;
+
+const u8 OAM_ObjWidth[3][4]  = { { 8, 16, 32, 64 }, { 16, 32, 32, 64 }, {  8,  8, 16, 32 } };
+const u8 OAM_ObjHeight[3][4] = { { 8, 16, 32, 64 }, {  8,  8, 16, 32 }, { 16, 32, 32, 64 } };
+
+// spans shorter than this are copied by the CPU, DMA setup costs more
+// than moving a couple of words
+#define OAM_DMA_MIN_ENTRIES 4
+
+// Go through all 128 OAM entries and for each of them,
+// zero them out and disable them. This prevents a mess of
+// sprites from appearing at 0,0 on initialization
+void OAM_Init() {
+	OBJ_ATTR *obj = OAM_Shadow;
+
+	// clear the whole 1KB block in one go, then flag each entry as disabled
+	memset32(obj, 0, sizeof(OAM_Shadow) / 4);
+	for(int i = 0; i < OAM_COUNT; i++)
+	{
+		BIT_SET(&obj->attr0, ATTR0_DISABLE);
+
+		obj++;
+	}
+
+	for(int i = 0; i < OAM_COUNT / 32; i++)
+	{
+		OAM_DirtyBits[i] = 0xFFFFFFFF;
+	}
+	OAM_Commit();
+}
+
+static inline u32 PopCount32(u32 x)
+{
+	x = x - ((x >> 1) & 0x55555555);
+	x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+	x = (x + (x >> 4)) & 0x0F0F0F0F;
+	return (x * 0x01010101) >> 24;
+}
+
+static inline void OAM_CopySpan(u32 start, u32 len)
+{
+	if(len >= OAM_DMA_MIN_ENTRIES)
+	{
+		DMA_Copy32(DMA_CHANNEL_GENERAL, (OBJ_ATTR *)OAM_MEM + start, &OAM_Shadow[start], len * sizeof(OBJ_ATTR) / 4);
+	}
+	else
+	{
+		// OAM only takes 16 or 32-bit writes
+		volatile u32 *dst = (volatile u32 *)((OBJ_ATTR *)OAM_MEM + start);
+		u32 *src = (u32 *)&OAM_Shadow[start];
+		for(u32 i = 0; i < len * 2; i++)
+		{
+			dst[i] = src[i];
+		}
+	}
+}
+
+// Upload the entries that changed since the last commit. Call this
+// right after Vsync() so the copy lands inside VBlank. Once more than
+// half the table is dirty a single full copy is cheaper than the spans
+void OAM_Commit() {
+	u32 dirty = 0;
+	for(u32 w = 0; w < OAM_COUNT / 32; w++)
+	{
+		dirty += PopCount32(OAM_DirtyBits[w]);
+	}
+
+	oamStats.dirtyEntries = dirty;
+	oamStats.spans = 0;
+	oamStats.bytesUploaded = 0;
+	oamStats.fullCopy = 0;
+
+	if(dirty == 0) return;
+
+	if(dirty > OAM_COUNT / 2)
+	{
+		DMA_Copy32(DMA_CHANNEL_GENERAL, OAM_MEM, OAM_Shadow, sizeof(OAM_Shadow) / 4);
+		oamStats.spans = 1;
+		oamStats.bytesUploaded = sizeof(OAM_Shadow);
+		oamStats.fullCopy = 1;
+	}
+	else
+	{
+		// walk the bitmap and copy each run of dirty entries
+		u32 spanStart = 0;
+		u32 spanLen = 0;
+		for(u32 w = 0; w < OAM_COUNT / 32; w++)
+		{
+			u32 bits = OAM_DirtyBits[w];
+			if(bits == 0 && spanLen == 0) continue;
+
+			for(u32 b = 0; b < 32; b++, bits >>= 1)
+			{
+				if(bits & 1)
+				{
+					if(spanLen == 0) spanStart = w * 32 + b;
+					spanLen++;
+				}
+				else if(spanLen)
+				{
+					OAM_CopySpan(spanStart, spanLen);
+					oamStats.spans++;
+					oamStats.bytesUploaded += spanLen * sizeof(OBJ_ATTR);
+					spanLen = 0;
+				}
+
+				// nothing else set in this word
+				if(spanLen == 0 && (bits >> 1) == 0) break;
+			}
+		}
+		if(spanLen)
+		{
+			OAM_CopySpan(spanStart, spanLen);
+			oamStats.spans++;
+			oamStats.bytesUploaded += spanLen * sizeof(OBJ_ATTR);
+		}
+	}
+
+	for(u32 w = 0; w < OAM_COUNT / 32; w++)
+	{
+		OAM_DirtyBits[w] = 0;
+	}
+}
+
+const OAM_CommitStats *OAM_Stats() {
+	return &oamStats;
+}
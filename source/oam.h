@@ -0,0 +1,89 @@
+#ifndef __OAM_H__
+#define __OAM_H__
+
+#include "gba.h"
+
+#define OAM_COUNT 128
+#define OAM_AFFINE_COUNT 32
+
+// Shadow copy of OAM. Game code writes here during the frame and
+// OAM_Commit() copies it to OAM_MEM at the start of VBlank, so sprites
+// never change while the screen is being drawn.
+// globals live in IWRAM, so writes here are zero wait-state
+extern OBJ_ATTR OAM_Shadow[OAM_COUNT];
+
+// one bit per entry, set when the shadow entry has changed since the
+// last commit. use OAM_Touch/OAM_AffineTouch rather than writing these
+extern u32 OAM_DirtyBits[OAM_COUNT / 32];
+
+// Mark an entry dirty and return its shadow copy for writing
+static inline OBJ_ATTR *OAM_Touch(u32 idx)
+{
+	OAM_DirtyBits[idx >> 5] |= 1u << (idx & 31);
+	return &OAM_Shadow[idx];
+}
+
+// Same as OAM_Touch for an affine matrix. Its four elements are spread
+// over entries idx*4 to idx*4+3, so all four get uploaded
+static inline OBJ_AFFINE *OAM_AffineTouch(u32 idx)
+{
+	OAM_DirtyBits[idx >> 3] |= 0xFu << ((idx & 7) * 4);
+	return (OBJ_AFFINE *)&OAM_Shadow[idx * 4];
+}
+
+// OBJ sizes in pixels by [shape][size]
+extern const u8 OAM_ObjWidth[3][4];
+extern const u8 OAM_ObjHeight[3][4];
+
+// Lines an entry covers: its height, doubled for double-size affine
+// OBJs. 0 for a disabled entry
+static inline u32 OAM_BoxHeight(const OBJ_ATTR *obj)
+{
+	u32 affine = (obj->attr0 >> ATTR0_ROTSCALEFLAG) & 1;
+	u32 dbl = (obj->attr0 >> ATTR0_DBLSIZE) & 1;
+	if(!affine && dbl) return 0;
+
+	u32 h = OAM_ObjHeight[(obj->attr0 >> ATTR0_OBJSHAPE) & 3][(obj->attr1 >> ATTR1_OBJSIZE) & 3];
+	return h << (affine & dbl);
+}
+
+// Lines [*top, *last] an entry covers on screen. Returns 0 if it's
+// disabled or entirely off the top or bottom. Y wraps at 256, so an
+// entry with y past the bottom of the screen shows at the top instead.
+// (A 128-line double-size OBJ just above the bottom edge shows in both
+// places, only the bottom part is given here, see OBJBudget_Add)
+static inline u32 OAM_Lines(const OBJ_ATTR *obj, u32 *top, u32 *last)
+{
+	u32 boxH = OAM_BoxHeight(obj);
+	if(boxH == 0) return 0;
+
+	u32 y = obj->attr0 & ATTR0_YCOORD_MASK;
+	u32 end = y + boxH;
+	if(y < SCREEN_HEIGHT)
+	{
+		*top = y;
+		*last = ((end < SCREEN_HEIGHT) ? end : SCREEN_HEIGHT) - 1;
+		return 1;
+	}
+	if(end > 256)
+	{
+		*top = 0;
+		*last = ((end - 256 < SCREEN_HEIGHT) ? end - 256 : SCREEN_HEIGHT) - 1;
+		return 1;
+	}
+	return 0;
+}
+
+// what the last commit uploaded
+typedef struct {
+	u32 dirtyEntries;
+	u32 spans;
+	u32 bytesUploaded;
+	u32 fullCopy;
+} OAM_CommitStats;
+
+void OAM_Init(void);
+void OAM_Commit(void);
+const OAM_CommitStats *OAM_Stats(void);
+
+#endif
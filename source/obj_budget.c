@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "obj_budget.h"
+#include "obj_mux.h"
+#include "mgba.h"
+
+void OBJBudget_Clear(OBJBudget *budget)
+{
+	memset(budget->delta, 0, sizeof(budget->delta));
+}
+
+IWRAM_CODE void OBJBudget_Add(OBJBudget *budget, const OBJ_ATTR *objs, u32 count)
+{
+	for(u32 i = 0; i < count; i++)
+	{
+		u32 top, last;
+		if(!OAM_Lines(&objs[i], &top, &last)) continue;
+
+		u32 cost = OBJBudget_Cycles(&objs[i]);
+		budget->delta[top] += cost;
+		budget->delta[last + 1] -= cost;
+
+		// the bottom of a tall one hanging over the bottom edge comes
+		// back in at the top
+		u32 end = (objs[i].attr0 & ATTR0_YCOORD_MASK) + OAM_BoxHeight(&objs[i]);
+		if(top > 0 && end > 256)
+		{
+			budget->delta[0] += cost;
+			budget->delta[end - 256] -= cost;
+		}
+	}
+}
+
+IWRAM_CODE void OBJBudget_Finish(OBJBudget *budget, u32 hblankFree)
+{
+	u32 limit = hblankFree ? OBJBUDGET_LINE_CYCLES_HBLANKFREE : OBJBUDGET_LINE_CYCLES;
+
+	// bin = cycles * BINS / limit, with the one division done up front.
+	// rounding can put a line one bin low at the edges, only the over
+	// bin is exact
+	u32 scale = (OBJBUDGET_BINS << 16) / limit + 1;
+
+	budget->budget = limit;
+	budget->linesOver = 0;
+	budget->worstCycles = 0;
+	budget->worstLine = 0;
+	memset(budget->histogram, 0, sizeof(budget->histogram));
+
+	i32 cycles = 0;
+	for(u32 line = 0; line < SCREEN_HEIGHT; line++)
+	{
+		cycles += budget->delta[line];
+		budget->cycles[line] = cycles;
+
+		u32 bin;
+		if((u32)cycles > limit)
+		{
+			bin = OBJBUDGET_BINS;
+			budget->linesOver++;
+		}
+		else
+		{
+			bin = ((u32)cycles * scale) >> 16;
+			if(bin >= OBJBUDGET_BINS) bin = OBJBUDGET_BINS - 1;
+		}
+		budget->histogram[bin]++;
+
+		if((u32)cycles > budget->worstCycles)
+		{
+			budget->worstCycles = cycles;
+			budget->worstLine = line;
+		}
+	}
+}
+
+#if defined(__DEBUG__) || defined(__HOST__)
+
+static OBJBudget frameBudget;
+#ifdef __DEBUG__
+static u8 frameLogged[OBJBUDGET_BINS + 1];
+#endif
+
+void OBJBudget_Frame(void)
+{
+	OBJBudget *budget = &frameBudget;
+
+	// the multiplexer's entries are off in the shadow, it adds its own
+	OBJBudget_Clear(budget);
+	OBJBudget_Add(budget, OAM_Shadow, OAM_COUNT);
+	OBJMux_AddToBudget(budget);
+	OBJBudget_Finish(budget, (*REG_DISPCNT >> DISPCNT_HBLANKFREE_SHIFT) & 1);
+
+#ifdef __DEBUG__
+	if(budget->linesOver || memcmp(budget->histogram, frameLogged, sizeof(frameLogged)) != 0)
+	{
+		const u8 *h = budget->histogram;
+		char debug_msg[DEBUG_MSG_LEN];
+		snprintf(debug_msg, DEBUG_MSG_LEN, "OBJ lines by eighths of %ld cycles: %d %d %d %d %d %d %d %d, over %d, busiest %ld on line %ld",
+			budget->budget, h[0], h[1], h[2], h[3], h[4], h[5], h[6], h[7], h[8], budget->worstCycles, budget->worstLine);
+		mgba_printf(budget->linesOver ? DEBUG_WARN : DEBUG_INFO, debug_msg);
+		memcpy(frameLogged, budget->histogram, sizeof(frameLogged));
+	}
+#endif
+}
+
+const OBJBudget *OBJBudget_Last(void)
+{
+	return &frameBudget;
+}
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef __OBJBUDGET_H__
+#define __OBJBUDGET_H__
+
+#include "gba.h"
+#include "oam.h"
+
+// Per-scanline OBJ rendering budget. The OBJ unit gets a fixed number of
+// cycles per line to draw every OBJ on it, fewer with HBLANKFREE set, and
+// the pixels of whatever doesn't fit are dropped. A regular OBJ costs its
+// width in cycles on each line it covers, an affine one twice the width
+// of its drawn area (doubled for double-size) plus 10.
+//
+// Costs go in as differences, +cost on an OBJ's top line and -cost past
+// its last, so adding an entry is two writes whatever its height and the
+// lines come out of one running sum at the end. Lines are also binned by
+// how much of the budget they use, an eighth of it per bin, and the last
+// bin holds the lines over it
+#define OBJBUDGET_LINE_CYCLES 1210
+#define OBJBUDGET_LINE_CYCLES_HBLANKFREE 954
+#define OBJBUDGET_BINS 8
+
+typedef struct {
+	i32 delta[SCREEN_HEIGHT + 1];
+	u16 cycles[SCREEN_HEIGHT];
+	u32 budget;
+	u32 linesOver;
+	u32 worstCycles;
+	u32 worstLine;
+	u8 histogram[OBJBUDGET_BINS + 1];
+} OBJBudget;
+
+// OBJ cycles an entry takes on each line it covers
+static inline u32 OBJBudget_Cycles(const OBJ_ATTR *obj)
+{
+	u32 affine = (obj->attr0 >> ATTR0_ROTSCALEFLAG) & 1;
+	u32 dbl = (obj->attr0 >> ATTR0_DBLSIZE) & 1;
+	u32 w = OAM_ObjWidth[(obj->attr0 >> ATTR0_OBJSHAPE) & 3][(obj->attr1 >> ATTR1_OBJSIZE) & 3];
+	return affine ? (w << dbl) * 2 + 10 : w;
+}
+
+void OBJBudget_Clear(OBJBudget *budget);
+// count `count` entries, disabled ones and ones off screen cost nothing
+IWRAM_CODE void OBJBudget_Add(OBJBudget *budget, const OBJ_ATTR *objs, u32 count);
+// sum the lines up against the budget for HBLANKFREE on or off
+IWRAM_CODE void OBJBudget_Finish(OBJBudget *budget, u32 hblankFree);
+
+// Debug and host builds check what goes up every frame: OAM_Shadow and
+// the multiplexer's sprites. The histogram is logged whenever it changes
+// and a warning whenever a line is over budget
+#if defined(__DEBUG__) || defined(__HOST__)
+#define OBJBUDGET_FRAME() OBJBudget_Frame()
+void OBJBudget_Frame(void);
+// the last frame's result
+const OBJBudget *OBJBudget_Last(void);
+#else
+#define OBJBUDGET_FRAME() do {} while(0)
+#endif
+
+#endif
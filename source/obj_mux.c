@@ -0,0 +1,295 @@
+#include <stdio.h>
+
+#include "obj_mux.h"
+#include "bit_control.h"
+#include "dma.h"
+#include "irq.h"
+#include "mgba.h"
+
+// the interrupt has a channel of its own, so it never lands between the
+// register writes of a transfer the main loop is setting up
+#define DMA_CHANNEL_OBJMUX 0
+
+// runs shorter than this are copied by the CPU, see oam.c
+#define OBJMUX_DMA_MIN_ENTRIES 4
+
+#define OBJMUX_WORDS (OAM_COUNT / 32)
+#define OBJMUX_BAND_NONE OBJMUX_BANDS
+
+static OBJ_ATTR muxQueue[OBJMUX_MAX];
+static u32 muxQueued;
+static u32 muxOverflow; // submits that found the list full
+
+// commit scratch: each queued sprite's band and last line, and the
+// queue in band order
+static u8 muxBand[OBJMUX_MAX];
+static u8 muxLast[OBJMUX_MAX];
+static u16 muxOrder[OBJMUX_MAX];
+
+static u32 muxFirst;
+static u32 muxCount;
+
+// what the commit built: the first band as a copy of the whole range,
+// the rest as the entries each band loads, in band order
+static OBJ_ATTR muxBase[OAM_COUNT] __attribute__((aligned(4)));
+static OBJ_ATTR muxLoads[OBJMUX_MAX] __attribute__((aligned(4)));
+static u8 muxLoadEntry[OBJMUX_MAX];
+static u16 muxBandLoads[OBJMUX_BANDS + 1]; // first load of each band
+static volatile u32 muxNextBand;
+static u32 muxIRQ; // the VCount interrupt is enabled
+
+static OBJMux_Stats muxStats;
+
+static inline u32 OBJMux_FirstLoadingBand(u32 band)
+{
+	while(band < OBJMUX_BANDS && muxBandLoads[band] == muxBandLoads[band + 1]) band++;
+	return band;
+}
+
+static inline u32 OBJMux_IRQLine(u32 band)
+{
+	return band * OBJMUX_BAND_LINES - OBJMUX_LEAD;
+}
+
+// Copy entries [from, to) of the band's loads to OAM, a run of
+// consecutive entries at a time
+static inline void OBJMux_Load(u32 from, u32 to)
+{
+	OBJ_ATTR *oam = (OBJ_ATTR *)OAM_MEM + muxFirst;
+	while(from < to)
+	{
+		u32 start = from;
+		u32 entry = muxLoadEntry[from];
+		do { from++; } while(from < to && muxLoadEntry[from] == entry + (from - start));
+
+		u32 len = from - start;
+		if(len >= OBJMUX_DMA_MIN_ENTRIES)
+		{
+			DMA_Copy32(DMA_CHANNEL_OBJMUX, oam + entry, &muxLoads[start], len * sizeof(OBJ_ATTR) / 4);
+		}
+		else
+		{
+			// OAM only takes 16 or 32-bit writes
+			volatile u32 *dst = (volatile u32 *)(oam + entry);
+			const u32 *src = (const u32 *)&muxLoads[start];
+			for(u32 i = 0; i < len * 2; i++)
+			{
+				dst[i] = src[i];
+			}
+		}
+	}
+}
+
+IWRAM_CODE static void OBJMux_VCount(void)
+{
+	u32 band = muxNextBand;
+	if(band >= OBJMUX_BANDS) return;
+
+	OBJMux_Load(muxBandLoads[band], muxBandLoads[band + 1]);
+
+	band = OBJMux_FirstLoadingBand(band + 1);
+	muxNextBand = band;
+	if(band < OBJMUX_BANDS) IRQ_SetVCount(OBJMux_IRQLine(band));
+}
+
+void OBJMux_Init(u32 first, u32 count)
+{
+	ASSERT(first + count <= OAM_COUNT);
+
+	muxFirst = first;
+	muxCount = count;
+	muxQueued = 0;
+	muxOverflow = 0;
+	muxNextBand = OBJMUX_BAND_NONE;
+	muxStats = (OBJMux_Stats){0};
+	for(u32 e = 0; e < count; e++)
+	{
+		muxBase[e] = (OBJ_ATTR){ .attr0 = 1 << ATTR0_DISABLE };
+	}
+	muxBandLoads[OBJMUX_BANDS] = 0;
+
+	IRQ_Disable(IRQ_VCOUNT);
+	muxIRQ = 0;
+}
+
+u32 OBJMux_Submit(const OBJ_ATTR *obj)
+{
+	if(muxQueued == OBJMUX_MAX)
+	{
+		muxOverflow++;
+		return 0;
+	}
+	muxQueue[muxQueued++] = *obj;
+	return 1;
+}
+
+static inline u32 OBJMux_PopCount(u32 x)
+{
+	x = x - ((x >> 1) & 0x55555555);
+	x = (x & 0x33333333) + ((x >> 2) & 0x33333333);
+	x = (x + (x >> 4)) & 0x0F0F0F0F;
+	return (x * 0x01010101) >> 24;
+}
+
+void OBJMux_Commit(void)
+{
+	if(muxCount == 0) return;
+
+	// nothing to show and nothing left up from the last frame
+	if(muxQueued == 0 && muxOverflow == 0 && muxStats.submitted == 0) return;
+
+	OBJMux_Stats stats = { .submitted = muxQueued + muxOverflow, .dropped = muxOverflow };
+
+	// bucket the visible sprites by band, keeping submission order
+	u16 bucketStart[OBJMUX_BANDS + 1] = {0};
+	u8 *band = muxBand;
+	u8 *last = muxLast;
+	u16 *order = muxOrder;
+	for(u32 i = 0; i < muxQueued; i++)
+	{
+		u32 top, bottom;
+		band[i] = OBJMUX_BAND_NONE;
+		if(!OAM_Lines(&muxQueue[i], &top, &bottom)) continue;
+
+		band[i] = top / OBJMUX_BAND_LINES;
+		last[i] = bottom;
+		bucketStart[band[i] + 1]++;
+	}
+	for(u32 b = 0; b < OBJMUX_BANDS; b++)
+	{
+		bucketStart[b + 1] += bucketStart[b];
+	}
+	u16 bucketFill[OBJMUX_BANDS];
+	for(u32 b = 0; b < OBJMUX_BANDS; b++)
+	{
+		bucketFill[b] = bucketStart[b];
+	}
+	for(u32 i = 0; i < muxQueued; i++)
+	{
+		if(band[i] != OBJMUX_BAND_NONE) order[bucketFill[band[i]]++] = i;
+	}
+
+	// free entries of the range, the first in the top bit of word 0 so
+	// the lowest comes out of a count-leading-zeros. Entries come back at
+	// the first band whose interrupt line is below their sprite
+	u32 free[OBJMUX_WORDS] = {0};
+	u32 release[OBJMUX_BANDS][OBJMUX_WORDS] = {{0}};
+	for(u32 e = 0; e < muxCount; e++)
+	{
+		free[e >> 5] |= 0x80000000u >> (e & 31);
+	}
+
+	// the base copy starts out as the range's entries switched off, with
+	// the affine matrix elements that share their last halfword kept
+	for(u32 e = 0; e < muxCount; e++)
+	{
+		muxBase[e] = (OBJ_ATTR){ .attr0 = 1 << ATTR0_DISABLE, .fill = OAM_Shadow[muxFirst + e].fill };
+	}
+
+	u32 loads = 0;
+	for(u32 b = 0; b < OBJMUX_BANDS; b++)
+	{
+		muxBandLoads[b] = loads;
+		for(u32 w = 0; w < OBJMUX_WORDS; w++)
+		{
+			free[w] |= release[b][w];
+		}
+
+		u32 dropped = 0;
+		for(u32 k = bucketStart[b]; k < bucketStart[b + 1]; k++)
+		{
+			u32 i = order[k];
+
+			u32 w = 0;
+			while(w < OBJMUX_WORDS && free[w] == 0) w++;
+			if(w == OBJMUX_WORDS)
+			{
+				dropped++;
+				continue;
+			}
+
+			u32 e = w * 32 + __builtin_clz(free[w]);
+			u32 bit = 0x80000000u >> (e & 31);
+			free[w] &= ~bit;
+
+			u32 back = (last[i] + OBJMUX_LEAD) / OBJMUX_BAND_LINES + 1;
+			if(back < OBJMUX_BANDS) release[back][w] |= bit;
+
+			OBJ_ATTR obj = muxQueue[i];
+			obj.fill = OAM_Shadow[muxFirst + e].fill;
+			if(b == 0)
+			{
+				muxBase[e] = obj;
+			}
+			else
+			{
+				muxLoads[loads] = obj;
+				muxLoadEntry[loads] = e;
+				loads++;
+			}
+		}
+
+		u32 freeCount = 0;
+		for(u32 w = 0; w < OBJMUX_WORDS; w++)
+		{
+			freeCount += OBJMux_PopCount(free[w]);
+		}
+		u32 live = muxCount - freeCount + dropped;
+		if(live > stats.bandPeak) stats.bandPeak = live;
+		stats.dropped += dropped;
+	}
+	muxBandLoads[OBJMUX_BANDS] = loads;
+	stats.reloads = loads;
+
+	// writing OAM while lines are drawn needs HBLANKFREE, which takes
+	// OBJ cycles away from every line (obj_budget.h)
+	if(loads) BIT_SET(REG_DISPCNT, DISPCNT_HBLANKFREE_SHIFT);
+	else      BIT_CLEAR(REG_DISPCNT, DISPCNT_HBLANKFREE_SHIFT);
+
+	// the first band goes up now, the interrupt loads the rest
+	DMA_Copy32(DMA_CHANNEL_OBJMUX, (OBJ_ATTR *)OAM_MEM + muxFirst, muxBase, muxCount * sizeof(OBJ_ATTR) / 4);
+
+	u32 next = OBJMux_FirstLoadingBand(1);
+	muxNextBand = next;
+	if(next < OBJMUX_BANDS)
+	{
+		IRQ_SetVCount(OBJMux_IRQLine(next));
+		if(!muxIRQ) IRQ_Enable(IRQ_VCOUNT, OBJMux_VCount);
+		muxIRQ = 1;
+		stats.irqs = 1;
+		for(u32 b = next + 1; b < OBJMUX_BANDS; b++)
+		{
+			if(muxBandLoads[b] != muxBandLoads[b + 1]) stats.irqs++;
+		}
+	}
+	else if(muxIRQ)
+	{
+		IRQ_Disable(IRQ_VCOUNT);
+		muxIRQ = 0;
+	}
+
+#ifdef __DEBUG__
+	if(stats.dropped)
+	{
+		char debug_msg[DEBUG_MSG_LEN];
+		snprintf(debug_msg, DEBUG_MSG_LEN, "OBJMux: %ld of %ld sprites dropped (band peak %ld of %ld entries)",
+			stats.dropped, stats.submitted, stats.bandPeak, muxCount);
+		mgba_printf(DEBUG_WARN, debug_msg);
+	}
+#endif
+
+	muxStats = stats;
+	muxQueued = 0;
+	muxOverflow = 0;
+}
+
+void OBJMux_AddToBudget(OBJBudget *budget)
+{
+	OBJBudget_Add(budget, muxBase, muxCount);
+	OBJBudget_Add(budget, muxLoads, muxBandLoads[OBJMUX_BANDS]);
+}
+
+const OBJMux_Stats *OBJMux_GetStats(void)
+{
+	return &muxStats;
+}
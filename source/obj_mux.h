@@ -0,0 +1,56 @@
+#ifndef __OBJMUX_H__
+#define __OBJMUX_H__
+
+#include "gba.h"
+#include "oam.h"
+#include "obj_budget.h"
+
+// OBJ multiplexer. Game code submits as many sprites a frame as it likes
+// and the multiplexer deals them out to a range of OAM entries, reusing
+// an entry further down the screen once the sprite in it has been drawn.
+//
+// Sprites are bucket sorted by their top line and grouped into bands of
+// OBJMUX_BAND_LINES lines. Sprites starting in the first band go out with
+// the VBlank upload, the others are loaded by a VCount interrupt
+// OBJMUX_LEAD lines before their band starts: the OBJ unit works a line
+// ahead, so an entry can only be taken over once its sprite ended above
+// that line. DMA copies each band's entries in runs, with HBLANKFREE set
+// for the frame so OAM can be written while a line is being drawn (that
+// costs OBJ cycles, see OBJMux_Stats).
+//
+// Submissions are for one frame: OBJMux_Commit() sorts and uploads them
+// and starts the list over. The OAM entries the multiplexer owns draw
+// under everything with a lower index
+#define OBJMUX_MAX 256
+#define OBJMUX_BAND_LINES 16
+#define OBJMUX_BANDS (SCREEN_HEIGHT / OBJMUX_BAND_LINES)
+#define OBJMUX_LEAD 2
+
+typedef struct {
+	u32 submitted;    // sprites submitted for the frame
+	u32 dropped;      // ones that didn't get an entry, or didn't fit the list
+	u32 bandPeak;     // most entries live in one band
+	u32 reloads;      // entries loaded mid-frame
+	u32 irqs;         // bands that needed the VCount interrupt
+} OBJMux_Stats;
+
+// Take over OAM entries [first, first + count). The entries have to be
+// kept out of anyone else's way, see OBJPool_Reserve. A count of 0 turns
+// the multiplexer off. The VCount interrupt is only enabled for frames
+// that load entries mid-frame
+void OBJMux_Init(u32 first, u32 count);
+
+// Queue a sprite for the next commit. Returns 0 if the list is full
+u32 OBJMux_Submit(const OBJ_ATTR *obj);
+
+// Sort the frame's sprites into bands, upload the first band and arm the
+// interrupt for the rest. Call right after OAM_Commit(), inside VBlank
+void OBJMux_Commit(void);
+
+// count every sprite the last commit put up, wherever it's loaded
+void OBJMux_AddToBudget(OBJBudget *budget);
+
+// what the last commit did
+const OBJMux_Stats *OBJMux_GetStats(void);
+
+#endif
@@ -3,42 +3,91 @@
 #include "obj_pool.h"
 
 
-OBJPool OBJPool_Create(i32 oamStartIdx, i32 len)
-{
-    // since there's only 128 OAM objs available,
-    // make sure the pool doesn't go beyond that
-    ASSERT(oamStartIdx + len <= 128);
+// bit for entry idx within its word
+#define OBJPOOL_BIT(idx) (0x80000000u >> ((idx) & 31))
 
-    OBJPool Result = {0};
-    Result.indexes = malloc(sizeof(i32) * len);
-    for(size_t i = 0; i < len; i++)
+void OBJPool_Init(OBJPool* pool)
+{
+    for(u32 i = 0; i < OBJPOOL_WORDS; i++)
     {
-        Result.indexes[i] = oamStartIdx + i;
+        pool->used[i] = 0;
     }
-    Result.length = len;
-    Result.poolIdx = 0;
+    pool->count = 0;
+    pool->highWater = 0;
+    pool->failures = 0;
+}
 
-    return Result;
+// mark entries [idx, idx + n) with `set`, the run can cross a word
+static void OBJPool_Mark(OBJPool* pool, u32 idx, u32 n, u32 set)
+{
+    while(n)
+    {
+        u32 bit = idx & 31;
+        u32 len = (32 - bit < n) ? 32 - bit : n;
+        u32 mask = (len == 32) ? 0xFFFFFFFF : ((0xFFFFFFFFu << (32 - len)) >> bit);
+        if(set) pool->used[idx >> 5] |= mask;
+        else    pool->used[idx >> 5] &= ~mask;
+        idx += len;
+        n -= len;
+    }
 }
 
-// return the current index number and then internally
-// increment it in the given struct
-i32 OBJPool_GetNextIdx(OBJPool* pool)
+i32 OBJPool_Acquire(OBJPool* pool, u32 n)
 {
-    i32 Result = pool->poolIdx;
+    ASSERT(n > 0 && n <= 32);
 
-    pool->poolIdx += 1;
-    if(pool->poolIdx >= pool->length)
+    for(u32 w = 0; w < OBJPOOL_WORDS; w++)
     {
-        pool->poolIdx = 0;
+        // this word's free bits followed by the next word's, so runs can
+        // start here and end over there
+        u64 free = ((u64)~pool->used[w] << 32);
+        if(w + 1 < OBJPOOL_WORDS) free |= (u32)~pool->used[w + 1];
+
+        // keep the bits that start a free run of n, doubling the length
+        // checked each step: log2(n) shift-ANDs at most
+        u64 runs = free;
+        u32 len = 1;
+        while(len < n)
+        {
+            u32 step = (len < n - len) ? len : n - len;
+            runs &= runs << step;
+            len += step;
+        }
+
+        u32 starts = runs >> 32;
+        if(starts == 0) continue;
+
+        u32 idx = w * 32 + __builtin_clz(starts);
+        OBJPool_Mark(pool, idx, n, 1);
+        pool->runLength[idx] = n;
+        pool->count += n;
+        if(pool->count > pool->highWater) pool->highWater = pool->count;
+        return idx;
     }
 
-#if __DEBUG__
+    pool->failures++;
+#ifdef __DEBUG__
     char debug_msg[DEBUG_MSG_LEN];
-    snprintf(debug_msg, DEBUG_MSG_LEN, "poolIdx = %ld", Result);
-    mgba_printf(DEBUG_DEBUG, debug_msg);
+    snprintf(debug_msg, DEBUG_MSG_LEN, "OBJPool: no run of %ld free OAM entries", n);
+    mgba_printf(DEBUG_WARN, debug_msg);
 #endif
+    return OBJPOOL_NONE;
+}
+
+void OBJPool_Release(OBJPool* pool, i32 idx)
+{
+    ASSERT(idx >= 0 && idx < OAM_COUNT);
+    ASSERT(pool->used[idx >> 5] & OBJPOOL_BIT(idx));
 
-    return Result;
+    u32 n = pool->runLength[idx];
+    OBJPool_Mark(pool, idx, n, 0);
+    pool->runLength[idx] = 0;
+    pool->count -= n;
 }
 
+void OBJPool_Reserve(OBJPool* pool, u32 idx, u32 n)
+{
+    ASSERT(idx + n <= OAM_COUNT);
+
+    OBJPool_Mark(pool, idx, n, 1);
+}
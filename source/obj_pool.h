@@ -1,18 +1,38 @@
 #ifndef __OBJPOOL_H__
 #define __OBJPOOL_H__
 
-#include <stdlib.h>
-
 #include "gba.h"
 #include "mgba.h"
+#include "oam.h"
+
+// OAM entry allocator. One bit per entry, set while it's taken, with the
+// first entry in the top bit of word 0 so count-leading-zeros finds the
+// lowest free index. Runs of entries come out contiguous. Lower indices
+// draw on top, so the fixed ranges GameInit reserves at the bottom (the
+// score digits, the player, see GAME_OAM_*) end up over everything the
+// pool hands out.
+// Acquire and release only touch the four bitmap words, no heap
+#define OBJPOOL_WORDS (OAM_COUNT / 32)
+#define OBJPOOL_NONE -1
 
 typedef struct OBJPool {
-    i32* indexes;
-    i32 length;
-    i32 poolIdx;
+    u32 used[OBJPOOL_WORDS];
+    u8 runLength[OAM_COUNT]; // entries taken by the acquire starting here
+    u32 count;               // entries in use
+    u32 highWater;           // most entries in use at once
+    u32 failures;            // acquires that didn't fit
 } OBJPool;
 
-OBJPool OBJPool_Create(i32 oamStartIdx, i32 len);
-i32 OBJPool_GetNextIdx(OBJPool* pool);
+void OBJPool_Init(OBJPool* pool);
+// lowest index of `n` free entries in a row (1 to 32), OBJPOOL_NONE if
+// there's no run that long
+i32 OBJPool_Acquire(OBJPool* pool, u32 n);
+// give back the run acquired at idx
+void OBJPool_Release(OBJPool* pool, i32 idx);
+// take entries [idx, idx + n) for good, for whoever manages them
+// without the pool (the game's fixed sprites, the multiplexer, see
+// obj_mux.h). They aren't counted
+// in `count` and `highWater`, which only track acquires
+void OBJPool_Reserve(OBJPool* pool, u32 idx, u32 n);
 
 #endif
@@ -0,0 +1,165 @@
+#ifdef __HOST__
+// clock_gettime
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include "profile.h"
+
+#ifdef __PROFILE__
+
+#include <stdio.h>
+#include "mgba.h"
+
+#ifdef __HOST__
+#include <time.h>
+#define PROFILE_UNIT "ns"
+#else
+#define PROFILE_UNIT "cyc"
+#endif
+
+typedef struct {
+	const char *name;
+	u32 frameTotal; // cost so far this frame
+	u32 frameHits;
+	u32 min;
+	u32 max;
+	u32 sum;
+	u32 frames; // frames in the window where the section ran
+} ProfileSection;
+
+ProfileScope Profile_Stack[PROFILE_DEPTH_MAX];
+u32 Profile_Depth;
+
+static ProfileSection profileSections[PROFILE_SECTIONS_MAX];
+static u32 profileSectionsLen;
+static u32 profileFrame;
+// cost of an empty BEGIN/END pair, taken off every measurement
+static u32 profileOverhead;
+
+#ifdef __HOST__
+u32 Profile_Now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (u32)(ts.tv_sec * 1000000000ull + ts.tv_nsec);
+}
+#endif
+
+static void Profile_ResetWindow(void)
+{
+	for(u32 i = 0; i < profileSectionsLen; i++)
+	{
+		profileSections[i].min = 0xFFFFFFFF;
+		profileSections[i].max = 0;
+		profileSections[i].sum = 0;
+		profileSections[i].frames = 0;
+	}
+	profileFrame = 0;
+}
+
+void Profile_Init(void)
+{
+#ifndef __HOST__
+	// timer 2 ticks every cycle, timer 3 counts its overflows
+	*TM2CNT = 0;
+	*TM3CNT = 0;
+	*TM2D = 0;
+	*TM3D = 0;
+	*TM3CNT = (1 << TMCNT_ENABLE) | (1 << TMCNT_CASCADE);
+	*TM2CNT = (1 << TMCNT_ENABLE);
+#endif
+
+	Profile_Depth = 0;
+	profileSectionsLen = 0;
+	profileOverhead = 0;
+
+	// calibrate with a throwaway section, keeping the cheapest run
+	u32 overhead = 0xFFFFFFFF;
+	for(u32 i = 0; i < 8; i++)
+	{
+		u32 start = Profile_Now();
+		u32 end = Profile_Now();
+		if(end - start < overhead) overhead = end - start;
+	}
+	profileOverhead = overhead;
+
+	Profile_ResetWindow();
+}
+
+u8 Profile_Register(const char *name)
+{
+	ASSERT(profileSectionsLen < PROFILE_SECTIONS_MAX);
+
+	ProfileSection *section = &profileSections[profileSectionsLen];
+	*section = (ProfileSection){0};
+	section->name = name;
+	section->min = 0xFFFFFFFF;
+
+	return profileSectionsLen++;
+}
+
+void Profile_Accumulate(u8 id, u32 cycles)
+{
+	ProfileSection *section = &profileSections[id];
+	section->frameTotal += (cycles > profileOverhead) ? cycles - profileOverhead : 0;
+	section->frameHits++;
+}
+
+static void Profile_Report(void)
+{
+	char debug_msg[DEBUG_MSG_LEN];
+
+	snprintf(debug_msg, DEBUG_MSG_LEN, "profile: %lu frames, overhead %lu " PROFILE_UNIT,
+			(unsigned long)profileFrame, (unsigned long)profileOverhead);
+#ifdef __HOST__
+	puts(debug_msg);
+#else
+	mgba_printf(DEBUG_INFO, debug_msg);
+#endif
+
+	for(u32 i = 0; i < profileSectionsLen; i++)
+	{
+		ProfileSection *section = &profileSections[i];
+		if(section->frames == 0) continue;
+
+		snprintf(debug_msg, DEBUG_MSG_LEN, "  %-12s min %6lu avg %6lu max %6lu " PROFILE_UNIT " (%lu frames)",
+				section->name,
+				(unsigned long)section->min,
+				(unsigned long)(section->sum / section->frames),
+				(unsigned long)section->max,
+				(unsigned long)section->frames);
+#ifdef __HOST__
+		puts(debug_msg);
+#else
+		mgba_printf(DEBUG_INFO, debug_msg);
+#endif
+	}
+}
+
+// Fold this frame's totals into the window stats
+void Profile_Frame(void)
+{
+	ASSERT(Profile_Depth == 0);
+
+	for(u32 i = 0; i < profileSectionsLen; i++)
+	{
+		ProfileSection *section = &profileSections[i];
+		if(section->frameHits == 0) continue;
+
+		if(section->frameTotal < section->min) section->min = section->frameTotal;
+		if(section->frameTotal > section->max) section->max = section->frameTotal;
+		section->sum += section->frameTotal;
+		section->frames++;
+
+		section->frameTotal = 0;
+		section->frameHits = 0;
+	}
+
+	if(++profileFrame >= PROFILE_WINDOW)
+	{
+		Profile_Report();
+		Profile_ResetWindow();
+	}
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef __PROFILE_H__
+#define __PROFILE_H__
+
+#include "gba.h"
+
+// Scoped profiler on top of cascaded timers 2 and 3 (one tick per CPU
+// cycle, 32 bits wide). Mark up code with
+//
+//     PROFILE_BEGIN("collision");
+//     ...
+//     PROFILE_END();
+//
+// and call PROFILE_FRAME() once per frame. Every PROFILE_WINDOW frames the
+// min/avg/max per-frame cost of each section is printed to the debug log.
+// Without __PROFILE__ every macro compiles to nothing
+
+#define PROFILE_SECTIONS_MAX 16
+#define PROFILE_DEPTH_MAX 8
+#define PROFILE_WINDOW 120
+#define PROFILE_UNREGISTERED 0xFF
+
+#ifdef __PROFILE__
+
+// each call site looks up its section once and keeps the id in a static
+#define PROFILE_BEGIN(name) do { \
+		static u8 profileId_ = PROFILE_UNREGISTERED; \
+		if(profileId_ == PROFILE_UNREGISTERED) profileId_ = Profile_Register(name); \
+		Profile_Begin(profileId_); \
+	} while(0)
+#define PROFILE_END() Profile_End()
+#define PROFILE_FRAME() Profile_Frame()
+#define PROFILE_INIT() Profile_Init()
+
+typedef struct {
+	u32 start;
+	u8 id;
+} ProfileScope;
+
+extern ProfileScope Profile_Stack[PROFILE_DEPTH_MAX];
+extern u32 Profile_Depth;
+
+void Profile_Init(void);
+u8   Profile_Register(const char *name);
+void Profile_Frame(void);
+void Profile_Accumulate(u8 id, u32 cycles);
+
+#ifdef __HOST__
+u32 Profile_Now(void);
+#else
+// timer 3 counts timer 2's overflows. re-read if it ticked over between
+// the two halves
+static inline u32 Profile_Now(void)
+{
+	u16 hi, lo;
+	do {
+		hi = *TM3D;
+		lo = *TM2D;
+	} while(hi != *TM3D);
+	return ((u32)hi << 16) | lo;
+}
+#endif
+
+static inline void Profile_Begin(u8 id)
+{
+	ProfileScope *scope = &Profile_Stack[Profile_Depth++];
+	scope->id = id;
+	scope->start = Profile_Now();
+}
+
+static inline void Profile_End(void)
+{
+	u32 now = Profile_Now();
+	ProfileScope *scope = &Profile_Stack[--Profile_Depth];
+	Profile_Accumulate(scope->id, now - scope->start);
+}
+
+#else
+
+#define PROFILE_BEGIN(name) do {} while(0)
+#define PROFILE_END() do {} while(0)
+#define PROFILE_FRAME() do {} while(0)
+#define PROFILE_INIT() do {} while(0)
+
+#endif
+
+#endif
@@ -26,7 +26,7 @@ xorwow(xorwow_state *state)
 
 // The state must be initialized to non-zero
 // period of 2^32 - 1
-u32
+IWRAM_CODE u32
 xorshift32(xorshift32_state *state)
 {
 	// Algorithm "xor" from p.4 of Marsaglia, "Xorshift RNGs"
@@ -37,9 +37,99 @@ xorshift32(xorshift32_state *state)
 	return state->a = x;
 }
 
-u32
+void
+xorwow_fill(xorwow_state *state, u32 *out, u32 count)
+{
+	for(u32 i = 0; i < count; i++)
+	{
+		out[i] = xorwow(state);
+	}
+}
+
+// the state stays in a register for the whole batch
+IWRAM_CODE void
+xorshift32_fill(xorshift32_state *state, u32 *out, u32 count)
+{
+	u32 x = state->a;
+	for(u32 i = 0; i < count; i++)
+	{
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		out[i] = x;
+	}
+	state->a = x;
+}
+
+// Lemire's nearly divisionless method. `range * x >> 32` is uniform
+// except that the low word of the product falls below 2^32 % range in a
+// few more cases for some results. that threshold only needs working out
+// (with the one remaining `%`) when the low word is below `range` at
+// all, which for the ranges used here is almost never
+#define RANDOM_BOUNDED(out, next, range) do { \
+		u64 m_ = (u64)(next) * (range); \
+		if((u32)m_ < (range)) \
+		{ \
+			u32 t_ = -(range) % (range); \
+			while((u32)m_ < t_) m_ = (u64)(next) * (range); \
+		} \
+		(out) = (u32)(m_ >> 32); \
+	} while(0)
+
+IWRAM_CODE u32
 xorshift32_range(xorshift32_state* state, u32 min, u32 max)
 {
-    u32 Result = min + (xorshift32(state) % (max - min));
-    return Result;
+	ASSERT(max > min);
+	u32 range = max - min;
+	u32 v;
+	RANDOM_BOUNDED(v, xorshift32(state), range);
+	return min + v;
+}
+
+IWRAM_CODE u32
+RandRing_Range(RandRing *ring, u32 min, u32 max)
+{
+	ASSERT(max > min);
+	u32 range = max - min;
+	u32 v;
+	RANDOM_BOUNDED(v, RandRing_Next(ring), range);
+	return min + v;
+}
+
+u32
+xorshift32_range_pow2(xorshift32_state* state, u32 min, u32 max)
+{
+	ASSERT(max > min);
+	u32 range = max - min;
+	if(range == 1) return min;
+
+	// just enough top bits to cover [0, range), at worst half the draws miss
+	u32 shift = __builtin_clz(range - 1);
+	u32 v;
+	do {
+		v = xorshift32(state) >> shift;
+	} while(v >= range);
+	return min + v;
+}
+
+void
+RandRing_Init(RandRing *ring, u32 seed)
+{
+	ring->state.a = seed;
+	ring->head = 0;
+	ring->count = 0;
+}
+
+// generate up to the end of the array, then wrap around for the rest
+IWRAM_CODE void
+RandRing_Refill(RandRing *ring)
+{
+	u32 tail = (ring->head + ring->count) & (RANDRING_LEN - 1);
+	u32 missing = RANDRING_LEN - ring->count;
+	u32 first = RANDRING_LEN - tail;
+	if(first > missing) first = missing;
+
+	xorshift32_fill(&ring->state, &ring->values[tail], first);
+	xorshift32_fill(&ring->state, &ring->values[0], missing - first);
+	ring->count = RANDRING_LEN;
 }
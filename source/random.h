@@ -19,8 +19,52 @@ typedef struct
 	u32 a;
 } xorshift32_state;
 
-u32 xorshift32(xorshift32_state* state);
-u32 xorshift32_range(xorshift32_state* state, u32 min, u32 max);
+IWRAM_CODE u32 xorshift32(xorshift32_state* state);
+
+// Batch generation, the next `count` values of the sequence into `out`
+void xorwow_fill(xorwow_state *state, u32 *out, u32 count);
+IWRAM_CODE void xorshift32_fill(xorshift32_state *state, u32 *out, u32 count);
+
+// Bounded values without a divide (the ARM7 has none, `%` is a libgcc
+// call). Both are unbiased, returning a value in [min, max)
+//
+// _range maps a 32-bit value onto the range with a 32x32->64 multiply
+// and keeps the high word (Lemire), redrawing only in the rare case the
+// low word lands in the biased sliver. _range_pow2 takes the top bits of
+// a value, enough to cover the range, and redraws when they're past it.
+// It needs no multiply, and is the quicker one for small ranges that are
+// close to a power of two
+IWRAM_CODE u32 xorshift32_range(xorshift32_state* state, u32 min, u32 max);
+u32 xorshift32_range_pow2(xorshift32_state* state, u32 min, u32 max);
+
+// Ring of pre-generated xorshift32 values, read in order. Refilling
+// generates ahead from the same state, so reading through the ring gives
+// exactly the sequence direct xorshift32() calls would. Top it up when
+// the CPU would otherwise sit in VBlankIntrWait; a read from an empty
+// ring generates the value on the spot
+#define RANDRING_LEN 32 // power of two
+
+typedef struct
+{
+	xorshift32_state state;
+	u32 values[RANDRING_LEN];
+	u32 head;  // next value to read
+	u32 count; // values generated and not read yet
+} RandRing;
+
+void RandRing_Init(RandRing *ring, u32 seed);
+IWRAM_CODE void RandRing_Refill(RandRing *ring);
+IWRAM_CODE u32 RandRing_Range(RandRing *ring, u32 min, u32 max);
+
+static inline u32 RandRing_Next(RandRing *ring)
+{
+	if(ring->count == 0) return xorshift32(&ring->state);
+
+	u32 value = ring->values[ring->head];
+	ring->head = (ring->head + 1) & (RANDRING_LEN - 1);
+	ring->count--;
+	return value;
+}
 
 
 #endif
@@ -0,0 +1,413 @@
+#ifdef __HOST__
+
+#include <stdio.h>
+#include <string.h>
+
+#include "render.h"
+
+#define RENDER_BG_COUNT 4
+#define RENDER_OBJ_COUNT 128
+#define RENDER_OBJ_TILES 0x10000 // OBJ character data starts at charblock 4
+
+u16 Render_Frame[SCREEN_HEIGHT][SCREEN_WIDTH];
+
+// slicing-by-8: crcTable[k] advances a byte through k more zero bytes,
+// so eight table lookups fold in a whole 64-bit word
+static u32 crcTable[8][256];
+
+// OBJ sizes in pixels by [shape][size]
+static const u8 objWidth[3][4]  = { { 8, 16, 32, 64 }, { 16, 32, 32, 64 }, {  8,  8, 16, 32 } };
+static const u8 objHeight[3][4] = { { 8, 16, 32, 64 }, {  8,  8, 16, 32 }, { 16, 32, 32, 64 } };
+
+// per-line layers hold palette indices, 0 is transparent. 4bpp pixels
+// are stored with their palette bank already applied
+static u8 bgLine[RENDER_BG_COUNT][SCREEN_WIDTH];
+static u8 objLine[SCREEN_WIDTH];
+static u8 objPrio[SCREEN_WIDTH];
+
+// OAM decoded into what the scanline loop needs. Rebuilt whenever OAM
+// differs from the copy it was built from, which for most frames means
+// once: comparing 1KB per line is much cheaper than decoding 128 entries
+typedef struct {
+	i16 x;
+	u8 y;
+	u8 w, h;       // sprite size
+	u8 boxW, boxH; // drawn area, twice the size for double-size affine
+	u8 prio;
+	u8 bank;
+	u8 is8bpp;
+	u8 hflip, vflip;
+	u8 affine;     // matrix index + 1, 0 for regular OBJs
+	u16 charName;
+} RenderObj;
+
+static OBJ_ATTR objCacheOAM[RENDER_OBJ_COUNT];
+static RenderObj objCache[RENDER_OBJ_COUNT];
+static u32 objCacheCount;
+static u32 objCacheValid;
+
+// objPrio of a pixel no OBJ covers
+#define RENDER_PRIO_NONE 4
+
+void Render_Init(void)
+{
+	memset(Render_Frame, 0, sizeof(Render_Frame));
+	objCacheValid = 0;
+
+	for(u32 i = 0; i < 256; i++)
+	{
+		u32 c = i;
+		for(u32 k = 0; k < 8; k++)
+		{
+			c = (c & 1) ? 0xEDB88320 ^ (c >> 1) : c >> 1;
+		}
+		crcTable[0][i] = c;
+	}
+	for(u32 i = 0; i < 256; i++)
+	{
+		for(u32 k = 1; k < 8; k++)
+		{
+			u32 prev = crcTable[k - 1][i];
+			crcTable[k][i] = crcTable[0][prev & 0xFF] ^ (prev >> 8);
+		}
+	}
+}
+
+// One line of a text BG. Works a tile at a time: the map entry and the
+// tile row are looked up once per 8 pixels
+static void Render_TextBG(u32 bg, u32 line)
+{
+	const u8 *vram = (const u8 *)Host_VRAM;
+	u16 cnt = *(BG0CNT + bg);
+	u32 hofs = *(BG0HOFS + bg * 2) & 0x1FF;
+	u32 vofs = *(BG0VOFS + bg * 2) & 0x1FF;
+
+	const u8 *chars = vram + ((cnt >> BGXCNT_CHARBASEBLOCK) & 3) * 0x4000;
+	u32 screenBase = (cnt >> BGXCNT_SCRNBASEBLOCK) & 0x1F;
+	u32 size = (cnt >> BGXCNT_SCREENSIZE) & 3;
+	u32 is8bpp = (cnt >> BGXCNT_COLORMODE) & 1;
+	u32 wideMask = (size & 1) ? 511 : 255;
+	u32 tallMask = (size & 2) ? 511 : 255;
+
+	u32 y = (line + vofs) & tallMask;
+	u32 block = screenBase;
+	// the second row of screenblocks comes after one or two blocks
+	if(y >= 256) block += (size == 3) ? 2 : 1;
+	const u16 *mapRow = (const u16 *)(vram + block * 0x800) + ((y >> 3) & 31) * 32;
+
+	u8 *out = bgLine[bg];
+	u32 x = (hofs) & wideMask;
+	u32 px = 0;
+	while(px < SCREEN_WIDTH)
+	{
+		// the right screenblock of a wide map sits right after the left one
+		const u16 *row = (x >= 256) ? mapRow + 0x400 : mapRow;
+		u16 entry = row[(x >> 3) & 31];
+		u32 tileY = (entry & (1 << 11)) ? 7 - (y & 7) : (y & 7);
+		u32 hflip = entry & (1 << 10);
+		u32 tile = entry & 0x3FF;
+
+		u32 start = x & 7;
+		u32 count = 8 - start;
+		if(count > SCREEN_WIDTH - px) count = SCREEN_WIDTH - px;
+
+		if(is8bpp)
+		{
+			const u8 *src = chars + tile * 64 + tileY * 8;
+			if(!hflip && count == 8)
+			{
+				memcpy(out, src, 8);
+				out += 8;
+			}
+			else if(!hflip)
+			{
+				memcpy(out, src + start, count);
+				out += count;
+			}
+			else
+			{
+				for(u32 i = start; i < start + count; i++) *out++ = src[7 - i];
+			}
+		}
+		else
+		{
+			const u8 *src = chars + tile * 32 + tileY * 4;
+			u8 bank = (entry >> 12) << 4;
+			for(u32 i = start; i < start + count; i++)
+			{
+				u32 tx = hflip ? 7 - i : i;
+				u8 pix = (src[tx >> 1] >> ((tx & 1) * 4)) & 0xF;
+				*out++ = pix ? (bank | pix) : 0;
+			}
+		}
+
+		px += count;
+		x = (x + count) & wideMask;
+	}
+}
+
+static void Render_DecodeOAM(void)
+{
+	const OBJ_ATTR *oam = (const OBJ_ATTR *)Host_OAM;
+
+	memcpy(objCacheOAM, oam, sizeof(objCacheOAM));
+	objCacheValid = 1;
+	objCacheCount = 0;
+
+	// kept in reverse OAM order, see Render_Objs
+	for(i32 i = RENDER_OBJ_COUNT - 1; i >= 0; i--)
+	{
+		u16 a0 = oam[i].attr0;
+		u16 a1 = oam[i].attr1;
+		u16 a2 = oam[i].attr2;
+
+		u32 isAffine = (a0 >> ATTR0_ROTSCALEFLAG) & 1;
+		u32 dblSize = (a0 >> ATTR0_DBLSIZE) & 1;
+		if(!isAffine && dblSize) continue; // disabled
+		u32 mode = (a0 >> ATTR0_OBJMODE) & 3;
+		if(mode >= 2) continue; // OBJ window and the prohibited mode draw nothing
+		u32 shape = (a0 >> ATTR0_OBJSHAPE) & 3;
+		if(shape == 3) continue;
+		u32 size = (a1 >> ATTR1_OBJSIZE) & 3;
+
+		RenderObj *obj = &objCache[objCacheCount++];
+		obj->x = a1 & 0x1FF;
+		if(obj->x >= 256) obj->x -= 512;
+		obj->y = a0 & 0xFF;
+		obj->w = objWidth[shape][size];
+		obj->h = objHeight[shape][size];
+		obj->boxW = (isAffine && dblSize) ? obj->w * 2 : obj->w;
+		obj->boxH = (isAffine && dblSize) ? obj->h * 2 : obj->h;
+		obj->prio = (a2 >> ATTR2_PRIORITY) & 3;
+		obj->bank = (a2 >> ATTR2_PALETTE) << 4;
+		obj->is8bpp = (a0 >> ATTR0_COLORMODE) & 1;
+		obj->hflip = !isAffine && (a1 & (1 << ATTR1_FLIPHOR));
+		obj->vflip = !isAffine && (a1 & (1 << ATTR1_FLIPVERT));
+		obj->affine = isAffine ? ((a1 >> ATTR1_ROTSCALEPARAM) & 31) + 1 : 0;
+		obj->charName = a2 & ATTR2_CHARNAME_MASK;
+	}
+}
+
+// Address of a row of one of the sprite's tiles. tx/ty are inside the sprite
+static inline const u8 *Render_ObjRow(const RenderObj *obj, u32 tx, u32 ty, u32 map1D)
+{
+	// character names count 32-byte units, 8bpp tiles take two
+	u32 tileSize = obj->is8bpp ? 2 : 1;
+	u32 rowStride = map1D ? (obj->w >> 3) * tileSize : 32;
+	u32 unit = (obj->charName + (ty >> 3) * rowStride + (tx >> 3) * tileSize) & 0x3FF;
+	return (const u8 *)Host_VRAM + RENDER_OBJ_TILES + unit * 32 + (ty & 7) * (obj->is8bpp ? 8 : 4);
+}
+
+static inline u8 Render_Texel(const RenderObj *obj, const u8 *row, u32 tx)
+{
+	if(obj->is8bpp) return row[tx & 7];
+	u8 pix = (row[(tx & 7) >> 1] >> ((tx & 1) * 4)) & 0xF;
+	return pix ? (obj->bank | pix) : 0;
+}
+
+// OBJs are drawn from the back of OAM to the front so a later (lower)
+// entry overwrites on equal priority, same as the hardware picking the
+// lowest OAM index
+static inline void Render_ObjPixel(i32 x, u8 color, u8 prio)
+{
+	if(color && prio <= objPrio[x])
+	{
+		objLine[x] = color;
+		objPrio[x] = prio;
+	}
+}
+
+static void Render_Objs(u32 line)
+{
+	const OBJ_AFFINE *affine = (const OBJ_AFFINE *)Host_OAM;
+	u32 map1D = (*REG_DISPCNT >> DISPCNT_OBJMAPPING_SHIFT) & 1;
+
+	if(!objCacheValid || memcmp(objCacheOAM, Host_OAM, sizeof(objCacheOAM)) != 0)
+	{
+		Render_DecodeOAM();
+	}
+
+	memset(objPrio, RENDER_PRIO_NONE, sizeof(objPrio));
+
+	for(u32 i = 0; i < objCacheCount; i++)
+	{
+		const RenderObj *obj = &objCache[i];
+
+		// y wraps around at 256
+		u32 sy = (u8)(line - obj->y);
+		if(sy >= obj->boxH) continue;
+		i32 x = obj->x;
+		if(x >= SCREEN_WIDTH || x + obj->boxW <= 0) continue;
+
+		i32 x0 = x < 0 ? -x : 0;
+		i32 x1 = (x + obj->boxW > SCREEN_WIDTH) ? SCREEN_WIDTH - x : obj->boxW;
+		u8 prio = obj->prio;
+
+		if(!obj->affine)
+		{
+			u32 ty = obj->vflip ? obj->h - 1 - sy : sy;
+
+			// a tile at a time, each tile row fetched once
+			for(i32 px = x0; px < x1; )
+			{
+				u32 tx = obj->hflip ? obj->w - 1 - px : (u32)px;
+				const u8 *row = Render_ObjRow(obj, tx, ty, map1D);
+				i32 run = obj->hflip ? (i32)(tx & 7) + 1 : 8 - (i32)(tx & 7);
+				if(run > x1 - px) run = x1 - px;
+
+				u8 *dst = &objLine[x + px];
+				u8 *dstPrio = &objPrio[x + px];
+				if(obj->is8bpp && !obj->hflip)
+				{
+					// the common case, no per-pixel decoding
+					const u8 *src = row + (tx & 7);
+					for(i32 k = 0; k < run; k++)
+					{
+						u8 color = src[k];
+						u32 take = color && prio <= dstPrio[k];
+						dst[k] = take ? color : dst[k];
+						dstPrio[k] = take ? prio : dstPrio[k];
+					}
+				}
+				else
+				{
+					for(i32 k = 0; k < run; k++)
+					{
+						u32 t = obj->hflip ? tx - k : tx + k;
+						Render_ObjPixel(x + px + k, Render_Texel(obj, row, t), prio);
+					}
+				}
+				px += run;
+			}
+		}
+		else
+		{
+			// texture coordinates relative to the sprite centre, 8.8 fixed
+			const OBJ_AFFINE *m = &affine[obj->affine - 1];
+			i32 dy = (i32)sy - obj->boxH / 2;
+			for(i32 px = x0; px < x1; px++)
+			{
+				i32 dx = px - obj->boxW / 2;
+				i32 tx = ((m->pa * dx + m->pb * dy) >> 8) + obj->w / 2;
+				i32 ty = ((m->pc * dx + m->pd * dy) >> 8) + obj->h / 2;
+				if(tx < 0 || ty < 0 || tx >= obj->w || ty >= obj->h) continue;
+				Render_ObjPixel(x + px, Render_Texel(obj, Render_ObjRow(obj, tx, ty, map1D), tx), prio);
+			}
+		}
+	}
+}
+
+void Render_Line(u32 line)
+{
+	u16 dispcnt = *REG_DISPCNT;
+	const u16 *bgPal = (const u16 *)Host_PAL;
+	const u16 *objPal = bgPal + 0x100;
+	u16 *out = Render_Frame[line];
+
+	if(dispcnt & (1 << DISPCNT_FORCEDBLANK_SHIFT))
+	{
+		for(u32 x = 0; x < SCREEN_WIDTH; x++) out[x] = 0x7FFF;
+		return;
+	}
+
+	// layers in drawing order: by priority, then BG number
+	u32 bgOrder[RENDER_BG_COUNT];
+	u32 bgPrio[RENDER_BG_COUNT];
+	u32 bgCount = 0;
+	if((dispcnt & 7) == 0)
+	{
+		for(u32 prio = 0; prio < 4; prio++)
+		{
+			for(u32 bg = 0; bg < RENDER_BG_COUNT; bg++)
+			{
+				if(!(dispcnt & (1 << (DISPCNT_BG0FLAG_SHIFT + bg)))) continue;
+				if((*(BG0CNT + bg) & 3) != prio) continue;
+				Render_TextBG(bg, line);
+				bgPrio[bgCount] = prio;
+				bgOrder[bgCount++] = bg;
+			}
+		}
+	}
+
+	if(dispcnt & (1 << DISPCNT_OBJFLAG_SHIFT)) Render_Objs(line);
+	else memset(objPrio, RENDER_PRIO_NONE, sizeof(objPrio));
+
+	// the first opaque BG pixel in front-to-back order, then the OBJ pixel
+	// if it's in front of that. OBJs win against BGs of the same priority
+	u16 backdrop = bgPal[0];
+	if(bgCount == 1)
+	{
+		const u8 *bgPix = bgLine[bgOrder[0]];
+		u8 prio = bgPrio[0];
+		for(u32 x = 0; x < SCREEN_WIDTH; x++)
+		{
+			u8 pix = bgPix[x];
+			u16 color = pix ? bgPal[pix] : backdrop;
+			u32 top = pix ? prio : RENDER_PRIO_NONE;
+			if(objPrio[x] != RENDER_PRIO_NONE && objPrio[x] <= top) color = objPal[objLine[x]];
+			out[x] = color & 0x7FFF;
+		}
+		return;
+	}
+
+	for(u32 x = 0; x < SCREEN_WIDTH; x++)
+	{
+		u16 color = backdrop;
+		u32 top = RENDER_PRIO_NONE;
+		for(u32 i = 0; i < bgCount; i++)
+		{
+			u8 pix = bgLine[bgOrder[i]][x];
+			if(pix)
+			{
+				color = bgPal[pix];
+				top = bgPrio[i];
+				break;
+			}
+		}
+		if(objPrio[x] != RENDER_PRIO_NONE && objPrio[x] <= top) color = objPal[objLine[x]];
+		out[x] = color & 0x7FFF;
+	}
+}
+
+u32 Render_CRC32(void)
+{
+	const u32 *data = (const u32 *)Render_Frame;
+	u32 crc = 0xFFFFFFFF;
+	// little endian, the frame is a whole number of 8-byte blocks
+	for(u32 i = 0; i < sizeof(Render_Frame) / 4; i += 2)
+	{
+		u32 lo = data[i] ^ crc;
+		u32 hi = data[i + 1];
+		crc = crcTable[7][lo & 0xFF] ^ crcTable[6][(lo >> 8) & 0xFF] ^
+		      crcTable[5][(lo >> 16) & 0xFF] ^ crcTable[4][lo >> 24] ^
+		      crcTable[3][hi & 0xFF] ^ crcTable[2][(hi >> 8) & 0xFF] ^
+		      crcTable[1][(hi >> 16) & 0xFF] ^ crcTable[0][hi >> 24];
+	}
+	return ~crc;
+}
+
+int Render_WritePPM(const char *path)
+{
+	FILE *f = fopen(path, "wb");
+	if(!f) return -1;
+
+	fprintf(f, "P6\n%d %d\n255\n", SCREEN_WIDTH, SCREEN_HEIGHT);
+	static u8 rgb[SCREEN_WIDTH * 3];
+	for(u32 y = 0; y < SCREEN_HEIGHT; y++)
+	{
+		for(u32 x = 0; x < SCREEN_WIDTH; x++)
+		{
+			u16 c = Render_Frame[y][x];
+			// 5 to 8 bits, copying the top bits into the bottom
+			u8 r = c & 31, g = (c >> 5) & 31, b = (c >> 10) & 31;
+			rgb[x * 3 + 0] = (r << 3) | (r >> 2);
+			rgb[x * 3 + 1] = (g << 3) | (g >> 2);
+			rgb[x * 3 + 2] = (b << 3) | (b >> 2);
+		}
+		fwrite(rgb, 1, sizeof(rgb), f);
+	}
+
+	return fclose(f);
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef __RENDER_H__
+#define __RENDER_H__
+
+// Software reference renderer for the host build. Composes the text BGs
+// and the OBJ layer of display mode 0 from the emulated VRAM, OAM and
+// palette one scanline at a time, so anything changed mid-frame (HBlank
+// DMA, VCount interrupts) shows up where it would on hardware.
+//
+// Covered: 4bpp/8bpp text BGs of any size with scrolling and tile flips,
+// regular and affine OBJs of every shape/size in 1D or 2D mapping, flips,
+// double-size, and BG/OBJ priorities. Not covered: bitmap and affine BG
+// modes, windows, blending and mosaic
+
+#ifdef __HOST__
+
+#include "gba.h"
+
+// BGR555, as in palette RAM
+extern u16 Render_Frame[SCREEN_HEIGHT][SCREEN_WIDTH];
+
+void Render_Init(void);
+
+// Draw one visible line from the current register/memory state.
+// Meant to be installed with Host_SetLineHook
+void Render_Line(u32 line);
+
+// CRC-32 (IEEE) of the current frame
+u32 Render_CRC32(void);
+
+// Dump the current frame as a binary PPM. Returns 0 on success
+int Render_WritePPM(const char *path);
+
+#endif
+
+#endif
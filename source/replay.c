@@ -0,0 +1,214 @@
+#include <stdio.h>
+
+#include "replay.h"
+#include "mgba.h"
+
+Replay Replay_State;
+
+#ifndef __HOST__
+// flashcarts and emulators look for this string in the ROM to pick the
+// save type
+const char Replay_SaveType[] __attribute__((used, aligned(4))) = "SRAM_V113";
+#endif
+
+// SRAM only takes byte accesses, everything wider is split up
+static u32 Replay_Read16(u32 pos)
+{
+	return SRAM_MEM[pos] | (SRAM_MEM[pos + 1] << 8);
+}
+
+static u32 Replay_Read32(u32 pos)
+{
+	return Replay_Read16(pos) | (Replay_Read16(pos + 2) << 16);
+}
+
+static void Replay_Write16(u32 pos, u32 value)
+{
+	SRAM_MEM[pos] = value;
+	SRAM_MEM[pos + 1] = value >> 8;
+}
+
+static void Replay_Write32(u32 pos, u32 value)
+{
+	Replay_Write16(pos, value);
+	Replay_Write16(pos + 2, value >> 16);
+}
+
+// there's always room for the pending run and the end marker, check
+// before writing anything else
+static u32 Replay_Room(u32 bytes)
+{
+	Replay *r = &Replay_State;
+	return r->pos + (r->runLeft ? 2 : 0) + bytes + 2 <= SRAM_SIZE;
+}
+
+static void Replay_FlushRun(void)
+{
+	Replay *r = &Replay_State;
+	if(r->runLeft == 0) return;
+
+	Replay_Write16(r->pos, r->runKeys | ((r->runLeft - 1) << 10));
+	r->pos += 2;
+	r->runLeft = 0;
+}
+
+// end marker and header for everything written so far, without moving
+// past the marker. a recording cut short by a reset is still good up to
+// the last checkpoint
+static void Replay_Seal(void)
+{
+	Replay *r = &Replay_State;
+	Replay_Write16(r->pos, REPLAY_EVENT_END);
+	Replay_Write32(0, REPLAY_MAGIC);
+	Replay_Write32(4, r->seed);
+	Replay_Write32(8, r->inputs);
+	Replay_Write32(12, r->pos - REPLAY_HEADER_SIZE);
+}
+
+void Replay_Record(u32 seed)
+{
+	Replay_State = (Replay){
+		.mode = REPLAY_RECORD,
+		.seed = seed,
+		.nextCheck = REPLAY_CHECK_EVERY,
+		.pos = REPLAY_HEADER_SIZE,
+	};
+	Replay_Seal();
+}
+
+void Replay_Stop(void)
+{
+	Replay *r = &Replay_State;
+	if(r->mode == REPLAY_RECORD)
+	{
+		Replay_FlushRun();
+		Replay_Seal();
+	}
+	r->mode = REPLAY_OFF;
+}
+
+u32 Replay_Play(u32 seed)
+{
+	if(Replay_Read32(0) != REPLAY_MAGIC || Replay_Read32(4) != seed) return 0;
+
+	u32 bytes = Replay_Read32(12);
+	if(bytes > SRAM_SIZE - REPLAY_HEADER_SIZE) return 0;
+
+	Replay_State = (Replay){
+		.mode = REPLAY_PLAY,
+		.seed = seed,
+		.nextCheck = REPLAY_CHECK_EVERY,
+		.pos = REPLAY_HEADER_SIZE,
+		.end = REPLAY_HEADER_SIZE + bytes,
+	};
+	return 1;
+}
+
+u32 Replay_Size(void)
+{
+	if(Replay_Read32(0) != REPLAY_MAGIC) return 0;
+	return REPLAY_HEADER_SIZE + Replay_Read32(12) + 2;
+}
+
+// next run from the stream. checkpoints that weren't asked for are
+// skipped, the ones that were are read by Replay_Check
+static u32 Replay_NextRun(void)
+{
+	Replay *r = &Replay_State;
+	while(r->pos + 2 <= r->end)
+	{
+		u32 event = Replay_Read16(r->pos);
+		if(event == REPLAY_EVENT_CHECK)
+		{
+			r->pos += 6;
+			continue;
+		}
+		if(event == REPLAY_EVENT_END) break;
+
+		r->pos += 2;
+		r->runKeys = event & 0x03FF;
+		r->runLeft = (event >> 10) + 1;
+		return 1;
+	}
+	return 0;
+}
+
+u16 Replay_Input(u16 keys)
+{
+	Replay *r = &Replay_State;
+
+	if(r->mode == REPLAY_PLAY)
+	{
+		if(r->runLeft == 0 && !Replay_NextRun())
+		{
+			// out of input, the player takes over
+			r->mode = REPLAY_OFF;
+			return keys;
+		}
+		r->runLeft--;
+		r->inputs++;
+		return r->runKeys;
+	}
+
+	if(r->mode == REPLAY_RECORD)
+	{
+		if(r->runLeft == 0 || r->runKeys != keys || r->runLeft == REPLAY_RUN_MAX)
+		{
+			if(!Replay_Room(2))
+			{
+				Replay_Stop();
+				r->mode = REPLAY_FULL;
+				return keys;
+			}
+			Replay_FlushRun();
+			r->runKeys = keys;
+		}
+		r->runLeft++;
+		r->inputs++;
+	}
+
+	return keys;
+}
+
+void Replay_Check(u32 checksum)
+{
+	Replay *r = &Replay_State;
+	r->nextCheck = r->inputs + REPLAY_CHECK_EVERY;
+
+	if(r->mode == REPLAY_RECORD)
+	{
+		if(!Replay_Room(6))
+		{
+			Replay_Stop();
+			r->mode = REPLAY_FULL;
+			return;
+		}
+		Replay_FlushRun();
+		Replay_Write16(r->pos, REPLAY_EVENT_CHECK);
+		Replay_Write32(r->pos + 2, checksum);
+		r->pos += 6;
+		r->checks++;
+		Replay_Seal();
+		return;
+	}
+
+	// recording always ends a run at a checkpoint, anything else means
+	// playback has already drifted off
+	u32 match = 0;
+	if(r->runLeft == 0 && r->pos + 6 <= r->end && Replay_Read16(r->pos) == REPLAY_EVENT_CHECK)
+	{
+		match = Replay_Read32(r->pos + 2) == checksum;
+		r->pos += 6;
+	}
+	r->checks++;
+
+	if(!match)
+	{
+		if(r->desyncs++ == 0) r->firstDesync = r->inputs;
+#ifdef __DEBUG__
+		char debug_msg[DEBUG_MSG_LEN];
+		snprintf(debug_msg, DEBUG_MSG_LEN, "replay desync at input %ld", r->inputs);
+		mgba_printf(DEBUG_WARN, debug_msg);
+#endif
+	}
+}
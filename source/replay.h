@@ -0,0 +1,83 @@
+#ifndef __REPLAY_H__
+#define __REPLAY_H__
+
+#include "gba.h"
+
+// Input recording and playback. Everything random in a run comes from
+// KEYINPUT and the RNG seed, so a session started from GameInit replays
+// exactly from the keys read by each UpdateButtonStates call.
+//
+// Recordings go to cartridge SRAM as a 16-byte header and a stream of
+// 16-bit events, low byte first:
+//
+//     kkkkkkkkkk rrrrrr    keys (KEYINPUT, 10 bits) held for r + 1 inputs
+//     1111111111 111111    end of stream
+//     1111111110 111111    checkpoint, followed by a 32-bit state checksum
+//
+// A flap is two events, four bytes. Holding one value costs two bytes
+// every REPLAY_RUN_MAX inputs, and a checkpoint six bytes every
+// REPLAY_CHECK_EVERY inputs, so the 32KB of SRAM hold well over an hour
+// of play. Playback compares the checksums at the same points and counts
+// the mismatches
+
+#define REPLAY_MAGIC 0x314C5052 // "RPL1"
+#define REPLAY_HEADER_SIZE 16
+#define REPLAY_RUN_MAX 63
+#define REPLAY_CHECK_EVERY 256
+
+#define REPLAY_EVENT_SPECIAL 0xFC00
+#define REPLAY_EVENT_END (REPLAY_EVENT_SPECIAL | 0x03FF)
+#define REPLAY_EVENT_CHECK (REPLAY_EVENT_SPECIAL | 0x03FE)
+
+typedef enum {
+	REPLAY_OFF,
+	REPLAY_RECORD,
+	REPLAY_PLAY,
+	REPLAY_FULL // recording stopped when SRAM ran out, kept until played
+} ReplayMode;
+
+typedef struct {
+	ReplayMode mode;
+	u32 seed;
+	u32 inputs;     // inputs recorded or played back so far
+	u32 nextCheck;  // input count the next checkpoint is due at
+	u32 pos;        // byte offset into SRAM
+	u32 end;        // playback: end of the stream
+	u16 runKeys;    // the run being recorded or played back
+	u16 runLeft;    // recording: length so far, playback: inputs left
+	u32 checks;
+	u32 desyncs;
+	u32 firstDesync; // input count of the first mismatch
+} Replay;
+
+extern Replay Replay_State;
+
+// Start recording over whatever is in SRAM. `seed` goes in the header
+// so playback can refuse a run made with a different one
+void Replay_Record(u32 seed);
+// Flush the last run and write the header. Recording also stops on its
+// own when SRAM is full
+void Replay_Stop(void);
+// Start playing back the recording in SRAM. Returns 0 if there's no
+// valid recording, or it was made with a different seed
+u32 Replay_Play(u32 seed);
+
+// Bytes of SRAM the recording takes up, header and end marker included.
+// 0 if there isn't one
+u32 Replay_Size(void);
+
+// Called by UpdateButtonStates with the live keys. Records them, or
+// swaps in the recorded ones during playback
+u16 Replay_Input(u16 keys);
+
+// Records or verifies a checksum of the game state. Only call it when
+// Replay_CheckDue() says so, the checksum isn't free
+void Replay_Check(u32 checksum);
+
+static inline u32 Replay_CheckDue(void)
+{
+	return (Replay_State.mode == REPLAY_RECORD || Replay_State.mode == REPLAY_PLAY)
+		&& Replay_State.inputs >= Replay_State.nextCheck;
+}
+
+#endif
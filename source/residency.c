@@ -0,0 +1,69 @@
+#include <stdio.h>
+
+#include "residency.h"
+#include "mgba.h"
+
+// sources start at generation 1, VRAM at 0 so everything is stale once
+static u16 sourceGen[RESIDENCY_MAX];
+static u16 residentGen[RESIDENCY_MAX];
+static Residency_Log residencyLog;
+
+static inline u32 Residency_SourceGen(u32 id)
+{
+	return sourceGen[id] + 1;
+}
+
+void Residency_Begin(void)
+{
+	residencyLog.count = 0;
+	residencyLog.bytes = 0;
+}
+
+u32 Residency_Stale(u32 id)
+{
+	ASSERT(id < RESIDENCY_MAX);
+	return residentGen[id] != Residency_SourceGen(id);
+}
+
+void Residency_Uploaded(u32 id, const char *name, u32 bytes)
+{
+	ASSERT(id < RESIDENCY_MAX);
+	residentGen[id] = Residency_SourceGen(id);
+
+	Residency_Upload *upload = &residencyLog.uploads[residencyLog.count++];
+	upload->name = name;
+	upload->bytes = bytes;
+	residencyLog.bytes += bytes;
+}
+
+void Residency_Changed(u32 id)
+{
+	ASSERT(id < RESIDENCY_MAX);
+	// skips 0 on the wrap so a bumped source never looks like empty VRAM
+	if(++sourceGen[id] == 0xFFFF) sourceGen[id] = 0;
+}
+
+void Residency_Invalidate(u32 id)
+{
+	ASSERT(id < RESIDENCY_MAX);
+	residentGen[id] = 0;
+}
+
+void Residency_End(void)
+{
+#ifdef __DEBUG__
+	char debug_msg[DEBUG_MSG_LEN];
+	snprintf(debug_msg, DEBUG_MSG_LEN, "Residency: %ld asset(s) uploaded, %ld bytes", residencyLog.count, residencyLog.bytes);
+	mgba_printf(DEBUG_DEBUG, debug_msg);
+	for(u32 i = 0; i < residencyLog.count; i++)
+	{
+		snprintf(debug_msg, DEBUG_MSG_LEN, "  %s: %ld bytes", residencyLog.uploads[i].name, residencyLog.uploads[i].bytes);
+		mgba_printf(DEBUG_DEBUG, debug_msg);
+	}
+#endif
+}
+
+const Residency_Log *Residency_GetLog(void)
+{
+	return &residencyLog;
+}
@@ -0,0 +1,44 @@
+#ifndef __RESIDENCY_H__
+#define __RESIDENCY_H__
+
+#include "gba.h"
+
+// VRAM and palette residency. Each asset (a palette, a block of tiles,
+// a tilemap) has two generation tags: the generation of its source and
+// the one sitting in VRAM, 0 for nothing. An init only uploads the
+// assets whose tags differ, so a restart after a game over finds all of
+// them resident and copies nothing.
+//
+// Whoever changes an asset's source calls Residency_Changed, whoever
+// draws over its VRAM calls Residency_Invalidate. Either makes it stale
+// for the next init. The tile streamer's slots aren't assets, only the
+// resident part of the sprite sheet before them is (see tile_stream.h)
+#define RESIDENCY_MAX 8
+
+typedef struct {
+	const char *name;
+	u32 bytes;
+} Residency_Upload;
+
+// what the last init uploaded
+typedef struct {
+	Residency_Upload uploads[RESIDENCY_MAX];
+	u32 count;
+	u32 bytes;
+} Residency_Log;
+
+// start a new log, call at the top of an init
+void Residency_Begin(void);
+// TRUE when asset `id` has to be uploaded
+u32 Residency_Stale(u32 id);
+// asset `id` has been uploaded, `bytes` of it
+void Residency_Uploaded(u32 id, const char *name, u32 bytes);
+// the source of `id` has changed
+void Residency_Changed(u32 id);
+// VRAM holding `id` has been written over
+void Residency_Invalidate(u32 id);
+// log the uploads to mgba in debug builds
+void Residency_End(void);
+const Residency_Log *Residency_GetLog(void);
+
+#endif
@@ -0,0 +1,437 @@
+#ifdef __HOST__
+
+// clock_gettime
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "runner.h"
+#include "host.h"
+#include "mem.h"
+#include "obj_budget.h"
+#include "obj_mux.h"
+#include "render.h"
+#include "replay.h"
+#include "residency.h"
+#include "sprites.h"
+#include "tile_stream.h"
+
+#define FNV_OFFSET 2166136261u
+#define FNV_PRIME 16777619u
+
+typedef struct {
+	u32 frames;
+	u32 oam;
+	u32 vram;
+	u32 game;
+	u32 frameCrc;
+	// every frame's hashes folded together, to compare whole runs
+	u32 run;
+} RunnerHashes;
+
+static u32 runnerFrameLimit;
+static u32 runnerLoop;
+static u32 runnerQuiet;
+static u32 runnerRender;
+static const char *runnerDumpDir;
+static u32 runnerDumpEvery = 1;
+static const char *runnerReplayIn;
+static const char *runnerReplayOut;
+static u32 runnerMuxSprites;
+static u32 runnerMinBestScore;
+
+static u16 *runnerScript;
+static u32 runnerScriptLen;
+
+static const GameScreenState *runnerGame;
+static u32 runnerScore;
+static u32 runnerBestScore;
+static u32 runnerDeaths;
+static u32 runnerFirstDeath;
+static u32 runnerLastDeath;
+static u32 runnerOAMHighWater;
+static u32 runnerOAMFailures;
+static OBJMux_Stats runnerMux; // worst of every frame, dropped is a total
+static u32 runnerOBJLinesOver;
+static u32 runnerOBJFramesOver;
+static u32 runnerOBJWorstCycles;
+static u32 runnerOBJWorstFrame;
+static u32 runnerStreamBytes;
+static u32 runnerStreamPeak;
+static u32 runnerStreamDeferred;
+static u32 runnerInits;
+static u32 runnerFirstInitBytes;
+static u32 runnerRestartBytes;
+
+static RunnerHashes runnerHashes;
+static struct timespec runnerStart;
+
+#define RUNNER_HASH_LANES 16
+
+// FNV-1a a word at a time over interleaved lanes, folded together at the
+// end. a single lane is bound by the multiply latency, and VRAM alone is
+// 24K words a frame. words past the last full row go through lane 0
+static u32 Runner_Hash(u32 hash, const void *data, u32 bytes)
+{
+	const u32 *word = data;
+	u32 words = bytes / 4;
+	u32 rows = words / RUNNER_HASH_LANES;
+	u32 lane[RUNNER_HASH_LANES];
+
+	for(u32 l = 0; l < RUNNER_HASH_LANES; l++) lane[l] = hash ^ l;
+
+	for(u32 r = 0; r < rows; r++, word += RUNNER_HASH_LANES)
+	{
+		for(u32 l = 0; l < RUNNER_HASH_LANES; l++)
+		{
+			lane[l] = (lane[l] ^ word[l]) * FNV_PRIME;
+		}
+	}
+	for(u32 i = rows * RUNNER_HASH_LANES; i < words; i++, word++)
+	{
+		lane[0] = (lane[0] ^ *word) * FNV_PRIME;
+	}
+
+	for(u32 l = 0; l < RUNNER_HASH_LANES; l++)
+	{
+		hash = (hash ^ lane[l]) * FNV_PRIME;
+	}
+	return hash;
+}
+
+// replay files are the used part of SRAM, header included
+static void Runner_SaveReplay(const char *path)
+{
+	u32 bytes = Replay_Size();
+	FILE *f = fopen(path, "wb");
+	if(!f || fwrite(Host_SRAM, 1, bytes, f) != bytes)
+	{
+		perror(path);
+		exit(1);
+	}
+	fclose(f);
+}
+
+static void Runner_LoadReplay(const char *path)
+{
+	FILE *f = fopen(path, "rb");
+	if(!f)
+	{
+		perror(path);
+		exit(1);
+	}
+	fread(Host_SRAM, 1, sizeof(Host_SRAM), f);
+	fclose(f);
+
+	if(!Replay_Play(GAME_SEED))
+	{
+		fprintf(stderr, "%s: not a replay, or recorded with another seed\n", path);
+		exit(1);
+	}
+}
+
+static double Runner_Elapsed(void)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - runnerStart.tv_sec) + (now.tv_nsec - runnerStart.tv_nsec) * 1e-9;
+}
+
+// prints the summary, returns the exit status
+static int Runner_Finish(void)
+{
+	double secs = Runner_Elapsed();
+
+	fprintf(stderr, "frames: %u in %.3fs (%.0f fps)\n",
+		runnerHashes.frames, secs, secs > 0 ? runnerHashes.frames / secs : 0.0);
+	if(runnerDeaths)
+	{
+		fprintf(stderr, "deaths: %u, first at frame %u, last at frame %u\n",
+			runnerDeaths, runnerFirstDeath, runnerLastDeath);
+	}
+	else
+	{
+		fprintf(stderr, "deaths: 0\n");
+	}
+	fprintf(stderr, "score: %u (best %u)\n", runnerScore, runnerBestScore);
+	fprintf(stderr, "oam: %u entries in use at most, %u failed acquires\n", runnerOAMHighWater, runnerOAMFailures);
+	if(runnerMux.submitted)
+	{
+		fprintf(stderr, "mux: %u sprites at most, %u dropped, %u entries live in a band at most, %u loaded mid-frame over %u interrupts\n",
+			runnerMux.submitted, runnerMux.dropped, runnerMux.bandPeak, runnerMux.reloads, runnerMux.irqs);
+	}
+	fprintf(stderr, "tiles: %u bytes streamed, %u at most in a frame, %u deferred, %u of 1024 OBJ chars in VRAM\n",
+		runnerStreamBytes, runnerStreamPeak, runnerStreamDeferred, TileStream_VRAMChars());
+	fprintf(stderr, "obj budget: %u lines over in %u frames, busiest line %u cycles (frame %u)\n",
+		runnerOBJLinesOver, runnerOBJFramesOver, runnerOBJWorstCycles, runnerOBJWorstFrame);
+	if(runnerInits)
+	{
+		fprintf(stderr, "assets: %u bytes uploaded by the first init, %u by the %u restarts after it\n",
+			runnerFirstInitBytes, runnerRestartBytes, runnerInits - 1);
+	}
+	if(Mem_HeapChecks() > 2) fprintf(stderr, "heap: grown by %u bytes over %u sessions\n", Mem_HeapGrowth(), Mem_HeapChecks() - 2);
+	fprintf(stderr, "run hash: %08x\n", runnerHashes.run);
+
+	const Replay *r = &Replay_State;
+	if(r->checks)
+	{
+		fprintf(stderr, "replay: %u inputs, %u checkpoints, %u desyncs", r->inputs, r->checks, r->desyncs);
+		if(r->desyncs) fprintf(stderr, " (first at input %u)", r->firstDesync);
+		fprintf(stderr, "\n");
+	}
+
+	if(runnerReplayOut)
+	{
+		Replay_Stop();
+		Runner_SaveReplay(runnerReplayOut);
+	}
+
+	if(runnerBestScore < runnerMinBestScore)
+	{
+		fprintf(stderr, "best score %u is under %u\n", runnerBestScore, runnerMinBestScore);
+		return 1;
+	}
+	return Mem_HeapGrowth() ? 1 : 0;
+}
+
+// Runs at the start of every VBlank: hash what the last frame produced,
+// then latch the input the next frame reads
+static void Runner_Frame(void)
+{
+	RunnerHashes *h = &runnerHashes;
+
+	h->frames = Host_FrameCount;
+	h->oam = Runner_Hash(FNV_OFFSET, Host_OAM, sizeof(Host_OAM));
+	h->vram = Runner_Hash(FNV_OFFSET, Host_VRAM, sizeof(Host_VRAM));
+	h->game = runnerGame ? GameScreenState_Checksum(runnerGame) : 0;
+	h->frameCrc = runnerRender ? Render_CRC32() : 0;
+	if(runnerGame)
+	{
+		runnerScore = runnerGame->score.value;
+		if(runnerGame->objPool.highWater > runnerOAMHighWater) runnerOAMHighWater = runnerGame->objPool.highWater;
+		if(runnerGame->objPool.failures > runnerOAMFailures) runnerOAMFailures = runnerGame->objPool.failures;
+	}
+
+	const OBJMux_Stats *mux = OBJMux_GetStats();
+	if(mux->submitted > runnerMux.submitted) runnerMux.submitted = mux->submitted;
+	if(mux->bandPeak > runnerMux.bandPeak) runnerMux.bandPeak = mux->bandPeak;
+	if(mux->reloads > runnerMux.reloads) runnerMux.reloads = mux->reloads;
+	if(mux->irqs > runnerMux.irqs) runnerMux.irqs = mux->irqs;
+	runnerMux.dropped += mux->dropped;
+
+	const TileStream_Stats *stream = TileStream_GetStats();
+	runnerStreamBytes += stream->bytes;
+	runnerStreamDeferred += stream->deferred;
+	if(stream->bytes > runnerStreamPeak) runnerStreamPeak = stream->bytes;
+
+	const OBJBudget *budget = OBJBudget_Last();
+	runnerOBJLinesOver += budget->linesOver;
+	if(budget->linesOver) runnerOBJFramesOver++;
+	if(budget->worstCycles > runnerOBJWorstCycles)
+	{
+		runnerOBJWorstCycles = budget->worstCycles;
+		runnerOBJWorstFrame = h->frames;
+	}
+
+	u32 frame[5] = { h->frames, h->oam, h->vram, h->game, h->frameCrc };
+	h->run = Runner_Hash(h->run, frame, sizeof(frame));
+
+	if(!runnerQuiet)
+	{
+		if(runnerRender) printf("%u %08x %08x %08x %u %08x\n", h->frames, h->oam, h->vram, h->game, runnerScore, h->frameCrc);
+		else             printf("%u %08x %08x %08x %u\n", h->frames, h->oam, h->vram, h->game, runnerScore);
+	}
+
+	if(runnerDumpDir && h->frames % runnerDumpEvery == 0)
+	{
+		char path[512];
+		snprintf(path, sizeof(path), "%s/frame%06u.ppm", runnerDumpDir, h->frames);
+		if(Render_WritePPM(path) != 0)
+		{
+			perror(path);
+			exit(1);
+		}
+	}
+
+	if(runnerFrameLimit && h->frames >= runnerFrameLimit)
+	{
+		fflush(stdout);
+		exit(Runner_Finish());
+	}
+
+	u32 idx = h->frames - 1;
+	if(runnerLoop && runnerScriptLen) idx %= runnerScriptLen;
+	*KEYINPUT = (idx < runnerScriptLen) ? runnerScript[idx] : 0x03FF;
+}
+
+static void Runner_LoadScript(const char *path)
+{
+	FILE *f = fopen(path, "r");
+	if(!f)
+	{
+		perror(path);
+		exit(1);
+	}
+
+	u32 cap = 1024;
+	runnerScript = malloc(cap * sizeof(u16));
+	runnerScriptLen = 0;
+
+	char line[128];
+	u32 lineNum = 0;
+	while(fgets(line, sizeof(line), f))
+	{
+		lineNum++;
+		char *hash = strchr(line, '#');
+		if(hash) *hash = '\0';
+
+		unsigned int keys, count = 1;
+		int fields = sscanf(line, "%x %u", &keys, &count);
+		if(fields <= 0) continue;
+		if(keys > 0x03FF)
+		{
+			fprintf(stderr, "%s:%u: KEYINPUT value %x out of range\n", path, lineNum, keys);
+			exit(1);
+		}
+
+		while(count--)
+		{
+			if(runnerScriptLen == cap)
+			{
+				cap *= 2;
+				runnerScript = realloc(runnerScript, cap * sizeof(u16));
+			}
+			runnerScript[runnerScriptLen++] = keys;
+		}
+	}
+
+	fclose(f);
+}
+
+static void Runner_Usage(const char *prog)
+{
+	fprintf(stderr, "usage: %s [-n frames] [-i script] [-l] [-q] [-r] [-d dir [-e n]] [-p replay] [-w replay] [-s sprites] [-b score]\n", prog);
+	exit(2);
+}
+
+void Runner_Init(int argc, char **argv)
+{
+	for(int i = 1; i < argc; i++)
+	{
+		if(strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+		{
+			runnerFrameLimit = strtoul(argv[++i], NULL, 0);
+		}
+		else if(strcmp(argv[i], "-i") == 0 && i + 1 < argc)
+		{
+			Runner_LoadScript(argv[++i]);
+		}
+		else if(strcmp(argv[i], "-l") == 0)
+		{
+			runnerLoop = 1;
+		}
+		else if(strcmp(argv[i], "-r") == 0)
+		{
+			runnerRender = 1;
+		}
+		else if(strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+		{
+			runnerDumpDir = argv[++i];
+			runnerRender = 1;
+		}
+		else if(strcmp(argv[i], "-e") == 0 && i + 1 < argc)
+		{
+			runnerDumpEvery = strtoul(argv[++i], NULL, 0);
+			if(runnerDumpEvery == 0) Runner_Usage(argv[0]);
+		}
+		else if(strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+		{
+			runnerReplayIn = argv[++i];
+		}
+		else if(strcmp(argv[i], "-w") == 0 && i + 1 < argc)
+		{
+			runnerReplayOut = argv[++i];
+		}
+		else if(strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+		{
+			runnerMuxSprites = strtoul(argv[++i], NULL, 0);
+			Game_MuxEntries = GAME_MUX_ENTRIES;
+		}
+		else if(strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+		{
+			runnerMinBestScore = strtoul(argv[++i], NULL, 0);
+		}
+		else if(strcmp(argv[i], "-q") == 0)
+		{
+			runnerQuiet = 1;
+		}
+		else
+		{
+			Runner_Usage(argv[0]);
+		}
+	}
+
+	Host_Init();
+	Host_SetFrameHook(Runner_Frame);
+	if(runnerReplayIn) Runner_LoadReplay(runnerReplayIn);
+	if(runnerRender)
+	{
+		Render_Init();
+		Host_SetLineHook(Render_Line);
+	}
+
+	runnerHashes = (RunnerHashes){ .run = FNV_OFFSET };
+	clock_gettime(CLOCK_MONOTONIC, &runnerStart);
+}
+
+// A field of digits falling behind the game, submitted after the game's
+// own frame so they go up with its next commit
+static void Runner_SubmitMuxSprites(void)
+{
+	for(u32 i = 0; i < runnerMuxSprites; i++)
+	{
+		u32 x = (i * 37) % SCREEN_WIDTH;
+		u32 y = (i * 11 + (i & 7) * 19 + Host_FrameCount * (1 + (i & 1))) & 0xFF;
+		OBJ_ATTR obj = {
+			.attr0 = ATTR0_YCOORD(y) | (1 << ATTR0_COLORMODE) | (SPRITE_Numbers_0_OBJSHAPE << ATTR0_OBJSHAPE),
+			.attr1 = ATTR1_XCOORD(x) | (SPRITE_Numbers_0_OBJSIZE << ATTR1_OBJSIZE),
+			.attr2 = ATTR2_CHARNAME(SPRITE_Numbers_0_CHARNAME + (i % 10) * 8),
+		};
+		OBJMux_Submit(&obj);
+	}
+}
+
+void Runner_GameState(GameStates next, const GameScreenState *game)
+{
+	if(runnerMuxSprites && (next == GAMESTATE_TITLESCREEN || next == GAMESTATE_GAMESCREEN)) Runner_SubmitMuxSprites();
+
+	// a session has just been set up
+	if(next == GAMESTATE_TITLESCREEN && !runnerGame)
+	{
+		if(runnerInits++ == 0) runnerFirstInitBytes = Residency_GetLog()->bytes;
+		else                   runnerRestartBytes += Residency_GetLog()->bytes;
+	}
+
+	switch(next)
+	{
+		case GAMESTATE_TITLESCREEN:
+		case GAMESTATE_GAMESCREEN:
+			runnerGame = game;
+			break;
+		case GAMESTATE_GAMEOVER:
+			runnerScore = game->score.value;
+			if(runnerScore > runnerBestScore) runnerBestScore = runnerScore;
+			if(runnerDeaths++ == 0) runnerFirstDeath = Host_FrameCount;
+			runnerLastDeath = Host_FrameCount;
+			runnerGame = NULL;
+			break;
+		default:
+			runnerGame = NULL;
+			break;
+	}
+}
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef __RUNNER_H__
+#define __RUNNER_H__
+
+// Headless driver for the host build. Runs the normal main() state machine
+// as fast as the host allows, feeding KEYINPUT from a script, and checks
+// every frame against the previous run by hashing what the game produced.
+//
+//     GBAJam2022 [-n frames] [-i script] [-l] [-q] [-r] [-d dir [-e n]]
+//                [-p replay] [-w replay] [-s sprites] [-b score]
+//
+//  -n  stop after that many frames, runs forever otherwise
+//  -i  input script, one KEYINPUT value (hex, active low) per frame.
+//      `3FE 30` holds the value for 30 frames, `#` starts a comment.
+//      keys are released once the script runs out
+//  -l  loop the script instead
+//  -q  don't print the per-frame trace, only the summary
+//  -r  draw every frame with the reference renderer (render.h)
+//  -d  also dump frames to dir/frameNNNNNN.ppm, every frame or every n
+//  -p  play back a replay (replay.h) instead of the script, until it ends
+//  -w  save the session recorded in SRAM to a replay file at exit
+//  -s  submit that many extra sprites a frame through the multiplexer
+//      (obj_mux.h), to see it cope
+//  -b  fail unless some session scored at least that much
+//
+// The trace on stdout is one line per frame:
+//
+//     <frame> <OAM hash> <VRAM hash> <game state hash> <score> [<frame CRC>]
+//
+// the hashes are FNV-1a, the frame CRC (only with -r) is the CRC-32 of
+// the rendered frame. The summary goes to stderr at exit, with the
+// checkpoint and desync counts when a replay was recorded or played.
+// The exit status is 1 if the heap grew from one session to the next
+// (Mem_HeapCheck), or if the best score fell short of -b. The soak run
+// in `make test` relies on both
+
+#ifdef __HOST__
+
+#include "game_states.h"
+
+void Runner_Init(int argc, char **argv);
+
+// Called by main() after every state machine step. `game` is only
+// looked at while it's live (title screen up to game over)
+void Runner_GameState(GameStates next, const GameScreenState *game);
+
+#endif
+
+#endif
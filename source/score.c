@@ -0,0 +1,77 @@
+#include "score.h"
+#include "bit_control.h"
+#include "oam.h"
+
+// a + 1 in packed BCD: the +6 on every nibble but the top makes a 9 carry
+// out of its nibble like a 15 would, then the 6 is taken back off the
+// nibbles that didn't carry
+static inline u32 Score_BCDIncrement(u32 a)
+{
+    u32 t1 = a + 0x06666666;
+    u32 t2 = t1 + 1;
+    u32 carries = ~(t2 ^ t1 ^ 1) & 0x11111110;
+    return t2 - ((carries >> 2) | (carries >> 3));
+}
+
+void Score_Init(Score *score, u32 digits, u32 suppressZeros)
+{
+    ASSERT(digits > 0 && digits <= SCORE_DIGITS_MAX);
+
+    score->value = 0;
+    score->bcd = 0;
+    score->max = 0x99999999 >> ((SCORE_DIGITS_MAX - digits) * 4);
+    score->dirty = 0xFFFFFFFF >> ((SCORE_DIGITS_MAX - digits) * 4);
+    score->digits = digits;
+    score->suppressZeros = suppressZeros;
+}
+
+u32 Score_Increment(Score *score)
+{
+    if(score->bcd == score->max) return FALSE;
+
+    u32 bcd = Score_BCDIncrement(score->bcd);
+    score->dirty |= bcd ^ score->bcd;
+    score->bcd = bcd;
+    score->value++;
+    return TRUE;
+}
+
+void Score_DrawOBJ(Score *score, const u32 *oamIdxs, u32 zeroCharName, u32 charsPerDigit)
+{
+    // the marked nibbles from the ones up, stopping after the last one
+    u32 n = 0;
+    for(u32 dirty = score->dirty; dirty; dirty >>= 4, n++)
+    {
+        if(!(dirty & 0xF)) continue;
+
+        OBJ_ATTR *obj = OAM_Touch(oamIdxs[score->digits - 1 - n]);
+        u32 digit = Score_Digit(score, n);
+        if(digit == SCORE_BLANK)
+        {
+            BIT_SET(&obj->attr0, ATTR0_DISABLE);
+            continue;
+        }
+        BF_SET(&obj->attr2, zeroCharName + digit * charsPerDigit, ATTR2_CHARNAME_LEN, ATTR2_CHARNAME_SHIFT);
+        BIT_CLEAR(&obj->attr0, ATTR0_DISABLE);
+    }
+    score->dirty = 0;
+}
+
+void Score_DrawBG(Score *score, BG_TxtMode_Tile *map, u32 zeroTile)
+{
+    u32 n = 0;
+    for(u32 dirty = score->dirty; dirty; dirty >>= 4, n++)
+    {
+        if(!(dirty & 0xF)) continue;
+
+        BG_TxtMode_Tile *cell = map + (score->digits - 1 - n) * 2;
+        u32 digit = Score_Digit(score, n);
+        u32 tile = (digit == SCORE_BLANK) ? 0 : zeroTile + digit * 4;
+        u32 step = (digit == SCORE_BLANK) ? 0 : 1;
+        cell[0] = tile;
+        cell[1] = tile + step;
+        cell[32] = tile + step * 2;
+        cell[33] = tile + step * 3;
+    }
+    score->dirty = 0;
+}
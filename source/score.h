@@ -0,0 +1,49 @@
+#ifndef __SCORE_H__
+#define __SCORE_H__
+
+#include "gba.h"
+
+// A score counter kept in packed BCD, a nibble per digit with the ones
+// at the bottom, so adding a point and getting at the digits costs a few
+// ALU ops instead of a divide per digit. Digits that changed since the
+// last draw are marked, and only those are redrawn.
+//
+// It saturates at all nines for its number of digits (up to 8). With
+// leading zeros suppressed the digits before the first significant one
+// are left blank, the ones digit always shows
+#define SCORE_DIGITS_MAX 8
+
+typedef struct Score {
+    u32 value;         // the same score in binary
+    u32 bcd;
+    u32 max;           // in BCD
+    u32 dirty;         // bits set in the nibble of each digit to redraw
+    u8 digits;
+    u8 suppressZeros;
+} Score;
+
+// zero, with every digit to be drawn
+void Score_Init(Score *score, u32 digits, u32 suppressZeros);
+// one more point, returns FALSE once it has saturated
+u32 Score_Increment(Score *score);
+
+// Redraw the marked digits as OBJs. oamIdxs has one entry per digit,
+// the most significant first. The digit sprites are `charsPerDigit` char
+// names apart from `zeroCharName` on; a blank digit's OBJ is disabled
+void Score_DrawOBJ(Score *score, const u32 *oamIdxs, u32 zeroCharName, u32 charsPerDigit);
+// Redraw the marked digits on a text BG, each as 2x2 8bpp tiles from a
+// 32-wide map, the most significant at `map`. The tiles of digit n are
+// zeroTile + 4n on, in the order of a 16x16 1D sprite: top left, top
+// right, bottom left, bottom right. Blank digits get tile 0
+void Score_DrawBG(Score *score, BG_TxtMode_Tile *map, u32 zeroTile);
+
+// digit n (0 for the ones), or SCORE_BLANK when it's a suppressed zero
+#define SCORE_BLANK 0xFF
+static inline u32 Score_Digit(const Score *score, u32 n)
+{
+    u32 digit = (score->bcd >> (n * 4)) & 0xF;
+    if(score->suppressZeros && n > 0 && (score->bcd >> (n * 4)) == 0) return SCORE_BLANK;
+    return digit;
+}
+
+#endif
@@ -929,3 +929,75 @@ const unsigned char SpriteTiles[SPRITETILES_LEN] __attribute__((aligned(4))) __a
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 
 	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
 };
+
+#define SPRITEMASKS_LEN 544
+const unsigned int SpriteMasks[SPRITEMASKS_LEN] __attribute__((aligned(4))) __attribute__((visibility("hidden"))) = {
+	0x000ff000, 0x007ffe00, 0x01ffff80, 0x03ffffc0, 0x07ffffe0, 0x0ffffff0, 0x1ffffff8, 0x3ffffffc, 
+	0x3ffffffc, 0x7ffffffe, 0x7ffffffe, 0x7ffffffe, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 
+	0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0x7ffffffe, 0x7ffffffe, 0x7ffffffe, 0x3ffffffc, 
+	0x3ffffffc, 0x1ffffff8, 0x0ffffff0, 0x07ffffe0, 0x03ffffc0, 0x01ffff80, 0x007ffe00, 0x000ff000, 
+	0x000ff000, 0x007ffe00, 0x01ffff80, 0x03ffffc0, 0x07ffffe0, 0x0ffffff0, 0x1ffffff8, 0x3ffffffc, 
+	0x3ffffffc, 0x7ffffffe, 0x7ffffffe, 0x7ffffffe, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 
+	0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0x7ffffffe, 0x7ffffffe, 0x7ffffffe, 0x3ffffffc, 
+	0x3ffffffc, 0x1ffffff8, 0x0ffffff0, 0x07ffffe0, 0x03ffffc0, 0x01ffff80, 0x007ffe00, 0x000ff000, 
+	0x3ffc0000, 0x7ffe0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 
+	0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0x7ffe0000, 0x3ffc0000, 
+	0x03e00000, 0x07f00000, 0x0ff00000, 0x1ff00000, 0x3ff00000, 0x3ff00000, 0x3ff00000, 0x1ff00000, 
+	0x0ff00000, 0x07f00000, 0x07f00000, 0x07f00000, 0x07f00000, 0x07f00000, 0x07f00000, 0x03e00000, 
+	0x3ffc0000, 0x7ffe0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 
+	0x07ff0000, 0x3ffe0000, 0x7ffe0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0x7ffe0000, 
+	0x7ffe0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0x7fff0000, 0x1fff0000, 0x1fff0000, 
+	0x1fff0000, 0x1fff0000, 0x7fff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0x7ffe0000, 
+	0x7c000000, 0xfde00000, 0xfff00000, 0xfff80000, 0xfff80000, 0xfffe0000, 0xffff0000, 0xffff0000, 
+	0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0x7ffe0000, 0x03f80000, 0x03f80000, 0x01f00000, 
+	0x7ffe0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xfffe0000, 0xfffe0000, 0xffff0000, 
+	0xffff0000, 0x7fff0000, 0x7fff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0x7ffe0000, 
+	0x7ffe0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xfffe0000, 0xfffe0000, 0xffff0000, 
+	0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0x7ffe0000, 
+	0x3ffc0000, 0x7ffe0000, 0xffff0000, 0xffff0000, 0xffff0000, 0x7fff0000, 0x3fff0000, 0x007f0000, 
+	0x00ff0000, 0x01ff0000, 0x01fe0000, 0x01fe0000, 0x01fe0000, 0x01fe0000, 0x01fe0000, 0x00fc0000, 
+	0x3ffc0000, 0x7ffe0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0x7ffe0000, 
+	0x7ffe0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0x7ffe0000, 0x3ffc0000, 
+	0x3ffc0000, 0x7ffe0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 
+	0xffff0000, 0x7fff0000, 0x7fff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0x7ffe0000, 0x3ffc0000, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0x7ffffe00, 0x3ffffc00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0x7ffffe00, 0x3ffffc00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x0007ff00, 
+	0x001fffe0, 0x07fffff0, 0x1c7ffff8, 0x1c7ffff8, 0x007ffff8, 0x007ffff8, 0x007ffff8, 0x007ffff8, 
+	0x00fffff8, 0x00fffff8, 0x00fffff0, 0x007fffe0, 0x007fffc0, 0x003ffc00, 0x003ff800, 0x003f0000, 
+	0x001e0000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x0007ff00, 
+	0x001fffe0, 0x003ffff0, 0x00fffff8, 0x017ffff8, 0x037ffff8, 0x067ffff8, 0x067ffff8, 0x0c7ffff8, 
+	0x0cfffff8, 0x00fffff8, 0x00fffff0, 0x00ffffe0, 0x00ffffc0, 0x01fffc00, 0x03fff800, 0x03ffe000, 
+	0x07ffc000, 0x07ff8000, 0x07fc0000, 0x0ff00000, 0x0f000000, 0x1c000000, 0x00000000, 0x00000000, 
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x0007ff00, 
+	0x001fffe0, 0x07fffff0, 0x1c7ffff8, 0x1c7ffff8, 0x007ffff8, 0x007ffff8, 0x007ffff8, 0x007ffff8, 
+	0x00fffff8, 0x00fffff8, 0x00fffff0, 0x007fffe0, 0x007fffc0, 0x007ffc00, 0x00fff800, 0x003f8000, 
+	0x005f0000, 0x01340000, 0x00580000, 0x01000000, 0x04000000, 0x00000000, 0x00000000, 0x00000000, 
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x0007ff00, 
+	0x071fffe0, 0x1cfffff0, 0x1c7ffff8, 0x007ffff8, 0x007ffff8, 0x007ffff8, 0x007ffff8, 0x007ffff8, 
+	0x00fffff8, 0x00fffff8, 0x00fffff0, 0x007fffe0, 0x007fffc0, 0x003ffc00, 0x003ff800, 0x001a8000, 
+	0x000c0000, 0x00500000, 0x00000000, 0x02000000, 0x08000000, 0x00000000, 0x00000000, 0x00000000, 
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x0007ff00, 
+	0x071fffe0, 0x1cfffff0, 0x1c7ffff8, 0x007ffff8, 0x007ffff8, 0x007ffff8, 0x007ffff8, 0x007ffff8, 
+	0x00fffff8, 0x00fffff8, 0x00fffff0, 0x007fffe0, 0x007fffc0, 0x003ffc00, 0x001ff800, 0x00000000, 
+	0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000
+};
\ No newline at end of file
@@ -5,92 +5,161 @@
 #define SPRITE_ButtonA_dark_CHARNAME 0
 #define SPRITE_ButtonA_dark_OBJSHAPE 0
 #define SPRITE_ButtonA_dark_OBJSIZE 2
+#define SPRITE_ButtonA_dark_WIDTH 32
+#define SPRITE_ButtonA_dark_HEIGHT 32
+#define SPRITE_ButtonA_dark_MASK (SpriteMasks + 0)
 
 #define SPRITE_ButtonA_light_CHARNAME 32
 #define SPRITE_ButtonA_light_OBJSHAPE 0
 #define SPRITE_ButtonA_light_OBJSIZE 2
+#define SPRITE_ButtonA_light_WIDTH 32
+#define SPRITE_ButtonA_light_HEIGHT 32
+#define SPRITE_ButtonA_light_MASK (SpriteMasks + 32)
 
 #define SPRITE_Numbers_0_CHARNAME 64
 #define SPRITE_Numbers_0_OBJSHAPE 0
 #define SPRITE_Numbers_0_OBJSIZE 1
+#define SPRITE_Numbers_0_WIDTH 16
+#define SPRITE_Numbers_0_HEIGHT 16
+#define SPRITE_Numbers_0_MASK (SpriteMasks + 64)
 
 #define SPRITE_Numbers_1_CHARNAME 72
 #define SPRITE_Numbers_1_OBJSHAPE 0
 #define SPRITE_Numbers_1_OBJSIZE 1
+#define SPRITE_Numbers_1_WIDTH 16
+#define SPRITE_Numbers_1_HEIGHT 16
+#define SPRITE_Numbers_1_MASK (SpriteMasks + 80)
 
 #define SPRITE_Numbers_2_CHARNAME 80
 #define SPRITE_Numbers_2_OBJSHAPE 0
 #define SPRITE_Numbers_2_OBJSIZE 1
+#define SPRITE_Numbers_2_WIDTH 16
+#define SPRITE_Numbers_2_HEIGHT 16
+#define SPRITE_Numbers_2_MASK (SpriteMasks + 96)
 
 #define SPRITE_Numbers_3_CHARNAME 88
 #define SPRITE_Numbers_3_OBJSHAPE 0
 #define SPRITE_Numbers_3_OBJSIZE 1
+#define SPRITE_Numbers_3_WIDTH 16
+#define SPRITE_Numbers_3_HEIGHT 16
+#define SPRITE_Numbers_3_MASK (SpriteMasks + 112)
 
 #define SPRITE_Numbers_4_CHARNAME 96
 #define SPRITE_Numbers_4_OBJSHAPE 0
 #define SPRITE_Numbers_4_OBJSIZE 1
+#define SPRITE_Numbers_4_WIDTH 16
+#define SPRITE_Numbers_4_HEIGHT 16
+#define SPRITE_Numbers_4_MASK (SpriteMasks + 128)
 
 #define SPRITE_Numbers_5_CHARNAME 104
 #define SPRITE_Numbers_5_OBJSHAPE 0
 #define SPRITE_Numbers_5_OBJSIZE 1
+#define SPRITE_Numbers_5_WIDTH 16
+#define SPRITE_Numbers_5_HEIGHT 16
+#define SPRITE_Numbers_5_MASK (SpriteMasks + 144)
 
 #define SPRITE_Numbers_6_CHARNAME 112
 #define SPRITE_Numbers_6_OBJSHAPE 0
 #define SPRITE_Numbers_6_OBJSIZE 1
+#define SPRITE_Numbers_6_WIDTH 16
+#define SPRITE_Numbers_6_HEIGHT 16
+#define SPRITE_Numbers_6_MASK (SpriteMasks + 160)
 
 #define SPRITE_Numbers_7_CHARNAME 120
 #define SPRITE_Numbers_7_OBJSHAPE 0
 #define SPRITE_Numbers_7_OBJSIZE 1
+#define SPRITE_Numbers_7_WIDTH 16
+#define SPRITE_Numbers_7_HEIGHT 16
+#define SPRITE_Numbers_7_MASK (SpriteMasks + 176)
 
 #define SPRITE_Numbers_8_CHARNAME 128
 #define SPRITE_Numbers_8_OBJSHAPE 0
 #define SPRITE_Numbers_8_OBJSIZE 1
+#define SPRITE_Numbers_8_WIDTH 16
+#define SPRITE_Numbers_8_HEIGHT 16
+#define SPRITE_Numbers_8_MASK (SpriteMasks + 192)
 
 #define SPRITE_Numbers_9_CHARNAME 136
 #define SPRITE_Numbers_9_OBJSHAPE 0
 #define SPRITE_Numbers_9_OBJSIZE 1
+#define SPRITE_Numbers_9_WIDTH 16
+#define SPRITE_Numbers_9_HEIGHT 16
+#define SPRITE_Numbers_9_MASK (SpriteMasks + 208)
 
 #define SPRITE_Obstacle_End_CHARNAME 144
 #define SPRITE_Obstacle_End_OBJSHAPE 0
 #define SPRITE_Obstacle_End_OBJSIZE 2
+#define SPRITE_Obstacle_End_WIDTH 32
+#define SPRITE_Obstacle_End_HEIGHT 32
+#define SPRITE_Obstacle_End_MASK (SpriteMasks + 224)
 
 #define SPRITE_Obstacle_Tile_01_CHARNAME 176
 #define SPRITE_Obstacle_Tile_01_OBJSHAPE 0
 #define SPRITE_Obstacle_Tile_01_OBJSIZE 2
+#define SPRITE_Obstacle_Tile_01_WIDTH 32
+#define SPRITE_Obstacle_Tile_01_HEIGHT 32
+#define SPRITE_Obstacle_Tile_01_MASK (SpriteMasks + 256)
 
 #define SPRITE_Obstacle_Tile_02_CHARNAME 208
 #define SPRITE_Obstacle_Tile_02_OBJSHAPE 0
 #define SPRITE_Obstacle_Tile_02_OBJSIZE 2
+#define SPRITE_Obstacle_Tile_02_WIDTH 32
+#define SPRITE_Obstacle_Tile_02_HEIGHT 32
+#define SPRITE_Obstacle_Tile_02_MASK (SpriteMasks + 288)
 
 #define SPRITE_ObstacleTop_End_CHARNAME 240
 #define SPRITE_ObstacleTop_End_OBJSHAPE 0
 #define SPRITE_ObstacleTop_End_OBJSIZE 2
+#define SPRITE_ObstacleTop_End_WIDTH 32
+#define SPRITE_ObstacleTop_End_HEIGHT 32
+#define SPRITE_ObstacleTop_End_MASK (SpriteMasks + 320)
 
 #define SPRITE_ObstacleTop_Tile_CHARNAME 272
 #define SPRITE_ObstacleTop_Tile_OBJSHAPE 0
 #define SPRITE_ObstacleTop_Tile_OBJSIZE 2
+#define SPRITE_ObstacleTop_Tile_WIDTH 32
+#define SPRITE_ObstacleTop_Tile_HEIGHT 32
+#define SPRITE_ObstacleTop_Tile_MASK (SpriteMasks + 352)
 
 #define SPRITE_Robo_1_CHARNAME 304
 #define SPRITE_Robo_1_OBJSHAPE 0
 #define SPRITE_Robo_1_OBJSIZE 2
+#define SPRITE_Robo_1_WIDTH 32
+#define SPRITE_Robo_1_HEIGHT 32
+#define SPRITE_Robo_1_MASK (SpriteMasks + 384)
 
 #define SPRITE_Robo_2_CHARNAME 336
 #define SPRITE_Robo_2_OBJSHAPE 0
 #define SPRITE_Robo_2_OBJSIZE 2
+#define SPRITE_Robo_2_WIDTH 32
+#define SPRITE_Robo_2_HEIGHT 32
+#define SPRITE_Robo_2_MASK (SpriteMasks + 416)
 
 #define SPRITE_Robo_3_CHARNAME 368
 #define SPRITE_Robo_3_OBJSHAPE 0
 #define SPRITE_Robo_3_OBJSIZE 2
+#define SPRITE_Robo_3_WIDTH 32
+#define SPRITE_Robo_3_HEIGHT 32
+#define SPRITE_Robo_3_MASK (SpriteMasks + 448)
 
 #define SPRITE_Robo_4_CHARNAME 400
 #define SPRITE_Robo_4_OBJSHAPE 0
 #define SPRITE_Robo_4_OBJSIZE 2
+#define SPRITE_Robo_4_WIDTH 32
+#define SPRITE_Robo_4_HEIGHT 32
+#define SPRITE_Robo_4_MASK (SpriteMasks + 480)
 
 #define SPRITE_Robo_5_CHARNAME 432
 #define SPRITE_Robo_5_OBJSHAPE 0
 #define SPRITE_Robo_5_OBJSIZE 2
+#define SPRITE_Robo_5_WIDTH 32
+#define SPRITE_Robo_5_HEIGHT 32
+#define SPRITE_Robo_5_MASK (SpriteMasks + 512)
 
 #define SPRITETILES_LEN 14848
 extern const unsigned char SpriteTiles[SPRITETILES_LEN] __attribute__((aligned(4))) __attribute__((visibility("hidden")));
 
+#define SPRITEMASKS_LEN 544
+extern const unsigned int SpriteMasks[SPRITEMASKS_LEN] __attribute__((aligned(4))) __attribute__((visibility("hidden")));
+
 #endif
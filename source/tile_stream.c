@@ -0,0 +1,118 @@
+#include <stdio.h>
+
+#include "tile_stream.h"
+#include "bit_control.h"
+#include "dma.h"
+#include "mgba.h"
+#include "oam.h"
+
+#define TILESTREAM_CHAR_BYTES 32
+
+TileStream TileStream_Streams[TILESTREAM_MAX];
+
+static const u8 *streamTiles;
+static u32 streamResident;
+static u32 streamCount;
+static u32 streamVRAMChars;
+// where the next flush starts, so a stream left waiting goes first
+static u32 streamFirst;
+static TileStream_Stats streamStats;
+
+void TileStream_Init(const void *tiles, u32 residentChars)
+{
+	streamTiles = tiles;
+	streamResident = residentChars;
+	streamCount = 0;
+	streamVRAMChars = residentChars;
+	streamFirst = 0;
+	streamStats = (TileStream_Stats){0};
+}
+
+u32 TileStream_Add(u32 oamIdx, u32 chars)
+{
+	ASSERT(streamCount < TILESTREAM_MAX);
+
+	TileStream *stream = &TileStream_Streams[streamCount];
+	stream->oamIdx = oamIdx;
+	stream->slot = streamVRAMChars;
+	stream->chars = chars;
+	stream->want = TILESTREAM_NONE;
+	stream->loaded = TILESTREAM_NONE;
+	stream->shown = TILESTREAM_NONE;
+	streamVRAMChars += chars;
+
+	return streamCount++;
+}
+
+static inline void TileStream_Point(TileStream *stream, u32 vramChar)
+{
+	BF_SET(&OAM_Touch(stream->oamIdx)->attr2, vramChar, ATTR2_CHARNAME_LEN, ATTR2_CHARNAME_SHIFT);
+	stream->shown = stream->want;
+}
+
+void TileStream_Flush(void)
+{
+	u32 budget = TILESTREAM_VBLANK_BYTES;
+	TileStream_Stats stats = {0};
+
+	u32 waiting = TILESTREAM_NONE;
+	for(u32 n = 0, i = streamFirst; n < streamCount; n++, i = (i + 1 == streamCount) ? 0 : i + 1)
+	{
+		TileStream *stream = &TileStream_Streams[i];
+		if(stream->want == stream->shown || stream->want == TILESTREAM_NONE) continue;
+
+		// resident frames are shown where they are, and a frame already
+		// in the slot only needs the pointer back
+		if(stream->want < streamResident)
+		{
+			TileStream_Point(stream, stream->want);
+			continue;
+		}
+		if(stream->want == stream->loaded)
+		{
+			TileStream_Point(stream, stream->slot);
+			continue;
+		}
+
+		u32 bytes = stream->chars * TILESTREAM_CHAR_BYTES;
+		if(bytes > budget)
+		{
+			stats.deferred++;
+			if(waiting == TILESTREAM_NONE) waiting = i;
+			continue;
+		}
+
+		DMA_Copy32(DMA_CHANNEL_GENERAL,
+			(u8 *)&tile_mem[4][0] + stream->slot * TILESTREAM_CHAR_BYTES,
+			streamTiles + stream->want * TILESTREAM_CHAR_BYTES,
+			bytes / 4);
+		stream->loaded = stream->want;
+		TileStream_Point(stream, stream->slot);
+
+		budget -= bytes;
+		stats.bytes += bytes;
+		stats.copies++;
+	}
+	if(waiting != TILESTREAM_NONE) streamFirst = waiting;
+
+#ifdef __DEBUG__
+	if(stats.deferred)
+	{
+		char debug_msg[DEBUG_MSG_LEN];
+		snprintf(debug_msg, DEBUG_MSG_LEN, "TileStream: %ld bytes streamed, %ld sprite(s) kept their old frame", stats.bytes, stats.deferred);
+		mgba_printf(DEBUG_WARN, debug_msg);
+	}
+#endif
+
+	streamStats = stats;
+}
+
+u32 TileStream_VRAMChars(void)
+{
+	return streamVRAMChars;
+}
+
+const TileStream_Stats *TileStream_GetStats(void)
+{
+	return &streamStats;
+}
@@ -0,0 +1,60 @@
+#ifndef __TILE_STREAM_H__
+#define __TILE_STREAM_H__
+
+#include "gba.h"
+
+// OBJ tile streaming. Only the start of the sprite sheet is loaded into
+// OBJ VRAM (charblock 4) up front; each streamed sprite gets a VRAM slot
+// past it, sized for one frame. Game code says which frame of the sheet
+// a sprite should show, and at the next VBlank the frame's tiles are
+// copied from ROM into the sprite's slot and its attr2 pointed there.
+// Frames in the resident part of the sheet are shown in place.
+//
+// The copies come out of a per-VBlank byte budget. A sprite whose frame
+// doesn't fit keeps showing what's already in VRAM for it, its last
+// resident or streamed frame, and gets another go at the next VBlank.
+//
+// Char names are in 32-byte units as in attr2, for both the sheet and
+// VRAM
+#define TILESTREAM_MAX 4
+#define TILESTREAM_NONE 0xFFFF
+// bytes copied per VBlank at most, a 32x32 8bpp frame is 1KB
+#define TILESTREAM_VBLANK_BYTES 4096
+
+typedef struct {
+	u16 oamIdx;
+	u16 slot;    // VRAM char name of the slot
+	u16 chars;   // slot size
+	u16 want;    // sheet char name to show
+	u16 loaded;  // sheet char name the slot holds
+	u16 shown;   // sheet char name attr2 shows
+} TileStream;
+
+typedef struct {
+	u32 bytes;    // copied at the last flush
+	u32 copies;
+	u32 deferred; // sprites left on their old frame for lack of budget
+} TileStream_Stats;
+
+// `tiles` is the sheet, char names [0, residentChars) of it have been
+// loaded to the start of charblock 4. Slots are handed out after them
+void TileStream_Init(const void *tiles, u32 residentChars);
+// a stream for the OBJ at oamIdx, with a slot of `chars` char names.
+// Returns its id
+u32 TileStream_Add(u32 oamIdx, u32 chars);
+// Copy what changed and repoint the OBJs. Call right after Vsync(),
+// before OAM_Commit() so the new attr2s go up in the same VBlank
+void TileStream_Flush(void);
+// VRAM char names in use, the resident part and the slots
+u32 TileStream_VRAMChars(void);
+const TileStream_Stats *TileStream_GetStats(void);
+
+extern TileStream TileStream_Streams[TILESTREAM_MAX];
+
+// the frame (sheet char name) the OBJ should show from the next VBlank
+static inline void TileStream_Show(u32 id, u32 charName)
+{
+	TileStream_Streams[id].want = charName;
+}
+
+#endif
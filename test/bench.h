@@ -0,0 +1,40 @@
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+// clock_gettime
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <time.h>
+
+#include "gba.h"
+
+// Host microbenchmarks, run by `make bench`. BENCH times `iters` runs of
+// `body`, which can use the loop counter `bi` to pick its inputs out of
+// a table so nothing folds to a constant, and prints nanoseconds per
+// run. Results go into benchSink to keep the work alive.
+//
+// These are host timings only, and are labelled as such. They rank the
+// alternatives on the host and catch regressions, they say nothing about
+// GBA cycles
+static volatile u32 benchSink;
+
+static inline unsigned long long Bench_Now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+#define BENCH(name, iters, body) do { \
+		unsigned long long t0_ = Bench_Now(); \
+		for(u32 bi = 0; bi < (iters); bi++) { body; } \
+		unsigned long long t1_ = Bench_Now(); \
+		printf("  %-32s %8.2f host ns\n", (name), (double)(t1_ - t0_) / (iters)); \
+	} while(0)
+
+// inputs are picked with `bi & BENCH_INPUT_MASK`
+#define BENCH_INPUTS 1024
+#define BENCH_INPUT_MASK (BENCH_INPUTS - 1)
+
+#endif
@@ -0,0 +1,50 @@
+#include "bench.h"
+#include "collision_detection.h"
+#include "random.h"
+
+// the packed tests next to the Rectangle ones they replace
+static Rectangle rects[BENCH_INPUTS];
+static PackedBox boxes[BENCH_INPUTS];
+
+static Rectangle RandomRect(xorshift32_state *s)
+{
+	return (Rectangle){
+		xorshift32_range(s, 0, 240), xorshift32_range(s, 0, 160),
+		xorshift32_range(s, 1, 32), xorshift32_range(s, 1, 32)
+	};
+}
+
+int main(void)
+{
+	xorshift32_state s = { 0x2545F491 };
+	for(u32 i = 0; i < BENCH_INPUTS; i++)
+	{
+		rects[i] = RandomRect(&s);
+		boxes[i] = PackedBox_FromRect(&rects[i]);
+	}
+
+	// the set as the game fills it: a screen's worth of boxes, scrolled
+	ColliderSet set;
+	ColliderSet_Clear(&set);
+	for(u32 i = 0; i < COLLIDERSET_MAX; i++) ColliderSet_Add(&set, &rects[i], i);
+	ColliderSet_Scroll(&set, 17);
+
+#define A (bi & BENCH_INPUT_MASK)
+#define B ((bi * 7 + 1) & BENCH_INPUT_MASK)
+	printf("collision:\n");
+	BENCH("CheckCollision_RectRect", 1 << 24, benchSink += CheckCollision_RectRect(&rects[A], &rects[B]));
+	BENCH("PackedBox_Overlap",       1 << 24, benchSink += PackedBox_Overlap(&boxes[A], &boxes[B]));
+	BENCH("RectRect x32",            1 << 20,
+		u32 m = 0;
+		for(u32 i = 0; i < 32; i++) m |= CheckCollision_RectRect(&rects[A], &rects[(B + i) & BENCH_INPUT_MASK]) << i;
+		benchSink += m);
+	BENCH("PackedBox_OverlapMask x32", 1 << 20, benchSink += PackedBox_OverlapMask(&boxes[A], &boxes[B & ~31], 32));
+	BENCH("RectRect over 32 boxes",  1 << 20,
+		u32 n = 0;
+		for(u32 i = 0; i < COLLIDERSET_MAX; i++) { Rectangle r = rects[i]; r.x -= 17; n += CheckCollision_RectRect(&rects[A], &r); }
+		benchSink += n);
+	BENCH("ColliderSet_Query, 32 boxes", 1 << 20,
+		u32 hits[COLLIDERSET_MAX];
+		benchSink += ColliderSet_Query(&set, &rects[A], hits, COLLIDERSET_MAX));
+	return 0;
+}
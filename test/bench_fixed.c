@@ -0,0 +1,32 @@
+#include "bench.h"
+#include "fixed.h"
+
+// per-call cost of each fixed.h operation over a table of inputs, so the
+// compiler can't fold the arguments
+static fp_t inA[BENCH_INPUTS], inB[BENCH_INPUTS];
+#define A inA[bi & BENCH_INPUT_MASK]
+#define B inB[bi & BENCH_INPUT_MASK]
+
+int main(void)
+{
+	u32 r = 0x2545F491;
+	for(u32 i = 0; i < BENCH_INPUTS; i++)
+	{
+		r ^= r << 13; r ^= r >> 17; r ^= r << 5;
+		inA[i] = (i32)r >> 8;
+		r ^= r << 13; r ^= r >> 17; r ^= r << 5;
+		inB[i] = ((i32)r >> 12) | 1;
+	}
+
+	printf("fixed:\n");
+	BENCH("fp_mul",   1 << 24, benchSink += fp_mul(A, B));
+	BENCH("fp8_mul",  1 << 24, benchSink += fp8_mul((fp8_t)A, (fp8_t)B));
+	BENCH("fp24_mul", 1 << 24, benchSink += fp24_mul(A >> 8, B));
+	BENCH("fp_div",   1 << 22, benchSink += fp_div(A, B));
+	BENCH("fp_recip", 1 << 22, benchSink += fp_recip(B));
+	BENCH("fp_sqrt",  1 << 22, benchSink += fp_sqrt(A));
+	BENCH("fp_sin",   1 << 24, benchSink += fp_sin((u32)A));
+	BENCH("fp_cos",   1 << 24, benchSink += fp_cos((u32)A));
+	BENCH("fp_atan2", 1 << 22, benchSink += fp_atan2(A, B));
+	return 0;
+}
@@ -0,0 +1,158 @@
+#include "bench.h"
+#include "game_states.h"
+#include "oam.h"
+#include "sprites.h"
+
+// the obstacle store as arrays with a list of live tiles, next to the
+// struct per obstacle with its 12 tile slots it replaced. Both hold the
+// same four obstacles, and run the game's per-frame scroll and OBJ
+// update and the mask test against the robot. Obstacles that leave on
+// the left come back on the right instead of being cleared, so the work
+// stays the same from frame to frame
+typedef struct OldObstacleTile {
+    u32 oamIdx;
+    i32 y;
+    u32 gapSize;
+    u32 active;
+    const u32 *mask; // collision mask of the sprite shown
+    u32 flipV;
+} OldObstacleTile;
+
+#define OLD_MAX_TILES_LEN 12
+typedef struct OldObstacle {
+    i32 x;
+    u32 y;
+    u32 gapSize;
+    u32 active;
+    u32 countedScore;
+    Rectangle bounding_box_top;
+    Rectangle bounding_box_btm;
+    OldObstacleTile tiles[OLD_MAX_TILES_LEN];
+} OldObstacle;
+
+static OldObstacle oldObstacles[OBSTACLES_MAX];
+static ObstacleSet set;
+static OBJPool pool;
+static i32 playerX = 60;
+static i32 playerY[BENCH_INPUTS];
+
+// the old layout filled in from the new one, tile for tile
+static void Old_FromSet(void)
+{
+    u32 used[OBSTACLES_MAX] = {0};
+    for(u32 slot = 0; slot < OBSTACLES_MAX; slot++)
+    {
+        OldObstacle *o = &oldObstacles[slot];
+        o->x = set.x[slot];
+        o->y = set.y[slot];
+        o->gapSize = set.gapSize[slot];
+        o->active = Obstacle_Active(&set, slot);
+        o->bounding_box_top = Rectangle_Create(0, -o->y, OBSTACLE_BOX_W, o->y - o->gapSize / 2);
+        o->bounding_box_btm = Rectangle_Create(0, o->gapSize / 2, OBSTACLE_BOX_W, SCREEN_HEIGHT - o->y);
+    }
+    for(u32 t = 0; t < set.tileCount; t++)
+    {
+        u32 flags = set.tileFlags[t];
+        OldObstacle *o = &oldObstacles[flags & OBSTACLE_TILE_SLOT_MASK];
+        OldObstacleTile *tile = &o->tiles[used[flags & OBSTACLE_TILE_SLOT_MASK]++];
+        tile->oamIdx = set.tileOAM[t];
+        tile->y = set.tileY[t];
+        tile->gapSize = o->gapSize;
+        tile->active = 1;
+        tile->mask = (flags & OBSTACLE_TILE_END) ? SPRITE_Obstacle_End_MASK : SPRITE_Obstacle_Tile_01_MASK;
+        tile->flipV = (flags & OBSTACLE_TILE_FLIPV) != 0;
+    }
+}
+
+__attribute__((noinline)) static void Old_Update(void)
+{
+    for(size_t i = 0; i < OBSTACLES_MAX; i++)
+    {
+        if(oldObstacles[i].active == 0) continue;
+
+        oldObstacles[i].x -= 1;
+        if(oldObstacles[i].x + oldObstacles[i].bounding_box_top.w < playerX && oldObstacles[i].countedScore == 0)
+        {
+            oldObstacles[i].countedScore = 1;
+        }
+        if(oldObstacles[i].x <= -32) oldObstacles[i].x += SCREEN_WIDTH + 64;
+
+        for(i32 j = 0; j < OLD_MAX_TILES_LEN; j++)
+        {
+            if(oldObstacles[i].tiles[j].active)
+            {
+                UpdateOBJPos(
+                        OAM_Touch(oldObstacles[i].tiles[j].oamIdx),
+                        WrapX(oldObstacles[i].x),
+                        oldObstacles[i].tiles[j].y
+                        );
+            }
+        }
+    }
+}
+
+__attribute__((noinline)) static u32 Old_CollideMask(const OldObstacle *obstacle, const CollisionMask *mask)
+{
+    for(u32 i = 0; i < OLD_MAX_TILES_LEN; i++)
+    {
+        const OldObstacleTile *tile = &obstacle->tiles[i];
+        if(!tile->active) continue;
+
+        i32 y = (tile->y >= SCREEN_HEIGHT) ? tile->y - (OBJMAXY + 1) : tile->y;
+        CollisionMask tileMask = { tile->mask, obstacle->x, y, OBSTACLE_TILE_SIZE, tile->flipV };
+        if(CheckCollision_MaskMask(mask, &tileMask)) return 1;
+    }
+    return 0;
+}
+
+__attribute__((noinline)) static void Set_Update(void)
+{
+    for(size_t i = 0; i < OBSTACLES_MAX; i++)
+    {
+        if(!Obstacle_Active(&set, i)) continue;
+
+        set.x[i] -= 1;
+        if(set.x[i] + OBSTACLE_BOX_W < playerX && !(set.countedScore & (1 << i)))
+        {
+            set.countedScore |= 1 << i;
+        }
+        if(set.x[i] <= -32) set.x[i] += SCREEN_WIDTH + 64;
+    }
+    for(u32 t = 0; t < set.tileCount; t++)
+    {
+        UpdateOBJPos(
+                OAM_Touch(set.tileOAM[t]),
+                WrapX(set.x[set.tileFlags[t] & OBSTACLE_TILE_SLOT_MASK]),
+                set.tileY[t]
+                );
+    }
+}
+
+int main(void)
+{
+    RandRing rand;
+    RandRing_Init(&rand, GAME_SEED);
+    OBJPool_Init(&pool);
+    for(u32 slot = 0; slot < OBSTACLES_MAX; slot++)
+    {
+        Obstacle_Create(&set, slot, &pool, &rand);
+        set.x[slot] = playerX - 16 + slot * 8; // all four over the robot
+    }
+    Old_FromSet();
+    for(u32 i = 0; i < BENCH_INPUTS; i++) playerY[i] = RandRing_Range(&rand, 0, SCREEN_HEIGHT - SPRITE_Robo_1_HEIGHT);
+
+#define MASK(y) (CollisionMask){ SPRITE_Robo_1_MASK, playerX, (y), SPRITE_Robo_1_HEIGHT, 0 }
+    printf("obstacles (%u bytes before, %u after):\n", (u32)sizeof(oldObstacles), (u32)sizeof(set));
+    BENCH("old: update, 4 obstacles",     1 << 20, Old_Update(); benchSink += oldObstacles[bi & 3].x);
+    BENCH("ObstacleSet update",           1 << 20, Set_Update(); benchSink += set.x[bi & 3]);
+
+    // the scroll above moved them apart, put them back over the robot
+    for(u32 slot = 0; slot < OBSTACLES_MAX; slot++) oldObstacles[slot].x = set.x[slot] = playerX - 16 + slot * 8;
+    BENCH("old: mask test, 4 obstacles",  1 << 20,
+        CollisionMask m = MASK(playerY[bi & BENCH_INPUT_MASK]);
+        for(u32 slot = 0; slot < OBSTACLES_MAX; slot++) benchSink += Old_CollideMask(&oldObstacles[slot], &m));
+    BENCH("Obstacle_CollideMask, 4",      1 << 20,
+        CollisionMask m = MASK(playerY[bi & BENCH_INPUT_MASK]);
+        for(u32 slot = 0; slot < OBSTACLES_MAX; slot++) benchSink += Obstacle_CollideMask(&set, slot, &m));
+    return 0;
+}
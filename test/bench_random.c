@@ -0,0 +1,25 @@
+#include "bench.h"
+#include "random.h"
+
+// per-value cost of each way of drawing from the generators. the `%`
+// line is the divide the bounded draws replace
+int main(void)
+{
+	xorshift32_state s = { 0x2545F491 };
+	xorwow_state w = { { 1, 2, 3, 4, 5 }, 0 };
+	RandRing ring;
+	RandRing_Init(&ring, 0x2545F491);
+	static u32 buf[RANDRING_LEN];
+
+	printf("random:\n");
+	BENCH("xorshift32",                1 << 24, benchSink += xorshift32(&s));
+	BENCH("xorwow",                    1 << 24, benchSink += xorwow(&w));
+	BENCH("xorshift32_fill (per 32)",  1 << 20, xorshift32_fill(&s, buf, RANDRING_LEN); benchSink += buf[bi & (RANDRING_LEN - 1)]);
+	BENCH("RandRing_Next, refilled",   1 << 24, if((bi & (RANDRING_LEN - 1)) == 0) RandRing_Refill(&ring); benchSink += RandRing_Next(&ring));
+	BENCH("RandRing_Next, empty",      1 << 24, benchSink += RandRing_Next(&ring));
+	BENCH("xorshift32 % 46",           1 << 24, benchSink += 50 + xorshift32(&s) % (46 + (bi & 1)));
+	BENCH("xorshift32_range 46",       1 << 24, benchSink += xorshift32_range(&s, 50, 96 + (bi & 1)));
+	BENCH("xorshift32_range_pow2 46",  1 << 24, benchSink += xorshift32_range_pow2(&s, 50, 96 + (bi & 1)));
+	BENCH("RandRing_Range 46",         1 << 24, if((bi & (RANDRING_LEN - 1)) == 0) RandRing_Refill(&ring); benchSink += RandRing_Range(&ring, 50, 96 + (bi & 1)));
+	return 0;
+}
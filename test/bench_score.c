@@ -0,0 +1,41 @@
+#include "bench.h"
+#include "score.h"
+#include "oam.h"
+#include "bit_control.h"
+
+// a point scored and drawn, counting 0 to 9999: the old `% 10` loop that
+// redrew all four digits next to the BCD counter that redraws the ones
+// that changed
+#define ZERO_CHAR 64
+#define CHARS_PER_DIGIT 8
+
+static const u32 idx[4] = { 10, 11, 12, 13 };
+
+__attribute__((noinline)) static void OldDraw(u32 score)
+{
+    u32 tmp = score;
+    for(i32 i = 3; i > -1; --i)
+    {
+        u32 digit = tmp % 10;
+        tmp /= 10;
+        BF_SET(&OAM_Touch(idx[i])->attr2, ZERO_CHAR + digit * CHARS_PER_DIGIT, ATTR2_CHARNAME_LEN, ATTR2_CHARNAME_SHIFT);
+    }
+}
+
+int main(void)
+{
+    u32 old = 0;
+    Score score;
+    Score_Init(&score, 4, FALSE);
+
+    printf("score:\n");
+    BENCH("old: % 10 per digit", 1 << 22,
+        if(old == 9999) old = 0;
+        OldDraw(++old);
+        benchSink += old);
+    BENCH("Score_Increment + DrawOBJ", 1 << 22,
+        if(!Score_Increment(&score)) Score_Init(&score, 4, FALSE);
+        Score_DrawOBJ(&score, idx, ZERO_CHAR, CHARS_PER_DIGIT);
+        benchSink += score.value);
+    return 0;
+}
@@ -0,0 +1,34 @@
+#ifndef __TEST_H__
+#define __TEST_H__
+
+#include <stdio.h>
+
+#include "gba.h"
+
+// Host test harness. Each test/test_*.c is a program linked against the
+// host objects (see `make test`). CHECK counts a failure and prints the
+// first few, TEST_END() prints the tally and is main's return value
+#define TEST_PRINT_MAX 10
+
+static u32 testChecks;
+static u32 testFailures;
+
+#define CHECK(expr) do { \
+		testChecks++; \
+		if(!(expr) && testFailures++ < TEST_PRINT_MAX) \
+			printf("%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #expr); \
+	} while(0)
+
+// the same with the two values printed
+#define CHECK_EQ(a, b) do { \
+		long long a_ = (long long)(a), b_ = (long long)(b); \
+		testChecks++; \
+		if(a_ != b_ && testFailures++ < TEST_PRINT_MAX) \
+			printf("%s:%d: CHECK_EQ(%s, %s) failed, %lld != %lld\n", __FILE__, __LINE__, #a, #b, a_, b_); \
+	} while(0)
+
+#define TEST_END() ( \
+		printf("%s: %u checks, %u failed\n", __FILE__, testChecks, testFailures), \
+		testFailures ? 1 : 0)
+
+#endif
@@ -0,0 +1,186 @@
+#include <stdlib.h>
+
+#include "test.h"
+#include "animation.h"
+#include "random.h"
+#include "sprites.h"
+
+// The ROM table animations against the heap ones they replaced, which
+// are kept below as they were. Both are driven with the same calls, one
+// update a frame like the game does, and have to show the same frame and
+// play state after every one. Animation_SetFrame is left out: the old
+// one looked the frame up in the char name table, which was a bug
+typedef enum OldAnimState
+{
+    OLDANIMSTATE_STOPPED,
+    OLDANIMSTATE_PLAYING
+} OldAnimState;
+
+typedef struct OldAnimation
+{
+    u32 timer;
+    u32 curFrame;
+    u32 ticksPerFrame;
+    OldAnimState state;
+    u8 loop;
+    u32 framesLen;
+    u32 frames[];
+} OldAnimation;
+
+static OldAnimation *OldAnimation_Create(u32 frames[], u32 framesLen, u32 fps, u8 loop)
+{
+    OldAnimation *Return = calloc(1, sizeof(OldAnimation) + sizeof(u32) * framesLen);
+    if(!Return) return NULL;
+
+    Return->timer = 0;
+    Return->framesLen = framesLen;
+    Return->curFrame = 0;
+    Return->ticksPerFrame = 60 / fps;
+    Return->state = OLDANIMSTATE_STOPPED;
+    Return->loop = loop;
+
+    for(size_t i = 0; i < framesLen; i++)
+    {
+        Return->frames[i] = frames[i];
+    }
+
+    return Return;
+}
+
+static void OldAnimation_Update(OldAnimation *anim, u32 ticks)
+{
+    if(anim->state == OLDANIMSTATE_STOPPED) return;
+
+    anim->timer += ticks;
+
+    anim->curFrame = anim->timer / anim->ticksPerFrame;
+    if(anim->curFrame >= anim->framesLen)
+    {
+        if(anim->loop)
+        {
+            anim->curFrame = anim->curFrame % anim->framesLen;
+        }
+        else
+        {
+            anim->curFrame = anim->framesLen - 1;
+            anim->state = OLDANIMSTATE_STOPPED;
+        }
+    }
+}
+
+static void OldAnimation_Play(OldAnimation *anim)    { anim->state = OLDANIMSTATE_PLAYING; }
+static void OldAnimation_Pause(OldAnimation *anim)   { anim->state = OLDANIMSTATE_STOPPED; }
+static void OldAnimation_Restart(OldAnimation *anim)
+{
+    anim->timer = 0;
+    anim->curFrame = 0;
+    anim->state = OLDANIMSTATE_PLAYING;
+}
+
+#define STEPS 400
+
+// one old and one new animation over the same frames, driven through
+// STEPS updates with restarts, plays and pauses dropped in at random
+static void Compare(xorshift32_state *s, const u32 *frames, u32 len, u32 fps, u8 loop)
+{
+    u16 frames16[8];
+    u8 durations[8];
+    for(u32 i = 0; i < len; i++)
+    {
+        frames16[i] = frames[i];
+        durations[i] = 60 / fps;
+    }
+    AnimationDef def = { frames16, durations, len, loop };
+
+    OldAnimation *old = OldAnimation_Create((u32 *)frames, len, fps, loop);
+    AnimationBank_Clear();
+    Animation *anim = AnimationBank_Add(&def);
+    CHECK(old && anim);
+    if(!old || !anim) return;
+
+    // both start stopped on the first frame, the game plays them itself
+    CHECK_EQ(Animation_CharName(anim), old->frames[old->curFrame]);
+    CHECK_EQ(anim->playing, old->state == OLDANIMSTATE_PLAYING);
+
+    for(u32 step = 0; step < STEPS; step++)
+    {
+        switch(xorshift32_range(s, 0, 40))
+        {
+            case 0: OldAnimation_Restart(old); Animation_Restart(anim); break;
+            case 1: OldAnimation_Play(old);    Animation_Play(anim);    break;
+            case 2: OldAnimation_Pause(old);   Animation_Pause(anim);   break;
+            default: break;
+        }
+        OldAnimation_Update(old, 1);
+        AnimationBank_UpdateAll();
+
+        CHECK_EQ(Animation_CharName(anim), old->frames[old->curFrame]);
+        CHECK_EQ(anim->playing, old->state == OLDANIMSTATE_PLAYING);
+    }
+
+    free(old);
+}
+
+// the frame rates that divide 60 evenly, the only ones the old timer
+// got right
+static const u32 rates[] = { 60, 30, 20, 15, 12, 10, 6, 5, 4, 3, 2, 1 };
+
+static void Test_Random(void)
+{
+    xorshift32_state s = { 0x2545F491 };
+    for(u32 n = 0; n < 20000; n++)
+    {
+        u32 frames[8];
+        u32 len = xorshift32_range(&s, 1, 9);
+        for(u32 i = 0; i < len; i++) frames[i] = xorshift32(&s) & 0x3FF;
+        u32 fps = rates[xorshift32_range(&s, 0, sizeof(rates) / sizeof(rates[0]))];
+        Compare(&s, frames, len, fps, xorshift32(&s) & 1);
+    }
+}
+
+// what the game plays: the robot's flap at 30fps and the A button at 8,
+// where 60 / 8 rounded down to the 7-frame durations
+static void Test_Game(void)
+{
+    xorshift32_state s = { 1 };
+    static const u32 flap[] = {
+        SPRITE_Robo_1_CHARNAME, SPRITE_Robo_2_CHARNAME, SPRITE_Robo_2_CHARNAME, SPRITE_Robo_3_CHARNAME,
+        SPRITE_Robo_3_CHARNAME, SPRITE_Robo_4_CHARNAME, SPRITE_Robo_4_CHARNAME, SPRITE_Robo_5_CHARNAME
+    };
+    static const u32 button[] = { SPRITE_ButtonA_dark_CHARNAME, SPRITE_ButtonA_light_CHARNAME };
+    for(u32 n = 0; n < 1000; n++)
+    {
+        Compare(&s, flap, 8, 30, FALSE);
+        Compare(&s, button, 2, 8, FALSE);
+    }
+}
+
+// SetFrame shows the frame it's given for its whole duration
+static void Test_SetFrame(void)
+{
+    static const u16 frames[] = { 10, 20, 30 };
+    static const u8 durations[] = { 1, 3, 2 };
+    static const AnimationDef def = { frames, durations, 3, TRUE };
+
+    AnimationBank_Clear();
+    Animation *anim = AnimationBank_Add(&def);
+    Animation_SetFrame(anim, 1);
+    Animation_Play(anim);
+    CHECK_EQ(Animation_CharName(anim), 20);
+    AnimationBank_UpdateAll();
+    AnimationBank_UpdateAll();
+    CHECK_EQ(Animation_CharName(anim), 20);
+    AnimationBank_UpdateAll();
+    CHECK_EQ(Animation_CharName(anim), 30);
+
+    // the bank holds ANIMATIONBANK_MAX and no more
+    for(u32 i = 1; i < ANIMATIONBANK_MAX; i++) CHECK(AnimationBank_Add(&def) != NULL);
+}
+
+int main(void)
+{
+    Test_Random();
+    Test_Game();
+    Test_SetFrame();
+    return TEST_END();
+}
@@ -0,0 +1,200 @@
+#include "test.h"
+#include "collision_detection.h"
+#include "random.h"
+
+// the packed boxes and the ColliderSet against CheckCollision_RectRect,
+// which is the definition of a hit
+#define SEED 0x2545F491
+
+static Rectangle RandomRect(xorshift32_state *s, i32 lo, i32 hi, u32 maxSize)
+{
+	Rectangle r;
+	r.w = xorshift32_range(s, 0, maxSize + 1);
+	r.h = xorshift32_range(s, 0, maxSize + 1);
+	r.x = (i32)xorshift32_range(s, 0, hi - lo - r.w) + lo;
+	r.y = (i32)xorshift32_range(s, 0, hi - lo - r.h) + lo;
+	return r;
+}
+
+// every pair of spans in a window, at the middle and at both ends of the
+// packed range. y always overlaps so x decides
+static void Test_Sweep1D(void)
+{
+	static const i32 origins[] = { -20, -PACKEDBOX_BIAS + 1, PACKEDBOX_BIAS - 42 };
+	for(u32 o = 0; o < sizeof(origins) / sizeof(origins[0]); o++)
+	{
+		for(i32 ax = 0; ax <= 20; ax++)
+		for(i32 aw = 0; aw <= 20; aw++)
+		for(i32 bx = 0; bx <= 20; bx++)
+		for(i32 bw = 0; bw <= 20; bw++)
+		{
+			Rectangle a = { origins[o] + ax, 0, aw, 1 };
+			Rectangle b = { origins[o] + bx, 0, bw, 1 };
+			PackedBox pa = PackedBox_FromRect(&a);
+			PackedBox pb = PackedBox_FromRect(&b);
+			CHECK_EQ(PackedBox_Overlap(&pa, &pb), CheckCollision_RectRect(&a, &b));
+			CHECK_EQ(PackedBox_Overlap(&pb, &pa), CheckCollision_RectRect(&a, &b));
+		}
+	}
+
+	// spans unpack to what went in and move as a whole
+	for(i32 min = -PACKEDBOX_BIAS; min < PACKEDBOX_BIAS; min += 7)
+	{
+		i32 max = min + 13 < PACKEDBOX_BIAS ? min + 13 : PACKEDBOX_BIAS - 1;
+		u32 span = PackedBox_Span(min, max);
+		CHECK_EQ(PackedBox_Min(span), min);
+		CHECK_EQ(PackedBox_Max(span), max);
+		if(min >= -PACKEDBOX_BIAS + 100)
+		{
+			CHECK_EQ(PackedBox_Min(PackedBox_Move(span, -100)), min - 100);
+			CHECK_EQ(PackedBox_Max(PackedBox_Move(span, -100)), max - 100);
+		}
+	}
+}
+
+static void Test_Random2D(void)
+{
+	xorshift32_state s = { SEED };
+	for(u32 n = 0; n < 1000000; n++)
+	{
+		// alternately all over the packed range and bunched up so that
+		// plenty of them touch
+		Rectangle a, b;
+		if(n & 1)
+		{
+			a = RandomRect(&s, -PACKEDBOX_BIAS, PACKEDBOX_BIAS, 4000);
+			b = RandomRect(&s, -PACKEDBOX_BIAS, PACKEDBOX_BIAS, 4000);
+		}
+		else
+		{
+			a = RandomRect(&s, -32, 32, 24);
+			b = RandomRect(&s, -32, 32, 24);
+		}
+		PackedBox pa = PackedBox_FromRect(&a);
+		PackedBox pb = PackedBox_FromRect(&b);
+		CHECK_EQ(PackedBox_Overlap(&pa, &pb), CheckCollision_RectRect(&a, &b));
+	}
+}
+
+static void Test_OverlapMask(void)
+{
+	xorshift32_state s = { SEED };
+	Rectangle rects[32];
+	PackedBox boxes[32];
+	for(u32 n = 0; n < 20000; n++)
+	{
+		u32 count = n % 33;
+		for(u32 i = 0; i < count; i++)
+		{
+			rects[i] = RandomRect(&s, 0, 128, 32);
+			boxes[i] = PackedBox_FromRect(&rects[i]);
+		}
+		Rectangle q = RandomRect(&s, 0, 128, 32);
+		PackedBox pq = PackedBox_FromRect(&q);
+
+		u32 expected = 0;
+		for(u32 i = 0; i < count; i++)
+		{
+			expected |= CheckCollision_RectRect(&q, &rects[i]) << i;
+		}
+		CHECK_EQ(PackedBox_OverlapMask(&pq, boxes, count), expected);
+	}
+}
+
+// The set against a flat list of boxes in world space. Boxes come in off
+// the right, the world scrolls left far enough to rebase many times, and
+// every query has to find the same boxes the brute force does. Boxes are
+// dropped from the list once they're past the left edge, where no query
+// reaches them, whether or not the set has culled them yet
+typedef struct {
+	Rectangle rect;
+	u32 id;
+} ListBox;
+
+static ListBox list[COLLIDERSET_MAX];
+static u32 listCount;
+
+static void Test_ColliderSet(void)
+{
+	xorshift32_state s = { SEED };
+	ColliderSet set;
+	ColliderSet_Clear(&set);
+	listCount = 0;
+	u32 nextId = 0;
+	i64 scroll = 0;
+	u32 rebases = 0;
+
+	for(u32 step = 0; step < 200000; step++)
+	{
+		if(set.count < COLLIDERSET_MAX && xorshift32_range(&s, 0, 3) == 0)
+		{
+			// mostly past the right edge, sometimes anywhere on screen
+			Rectangle r = RandomRect(&s, 0, 160, 48);
+			r.x = xorshift32_range(&s, 0, 8) ? 240 + (i32)xorshift32_range(&s, 0, 64) : (i32)xorshift32_range(&s, 0, 240);
+			CHECK(ColliderSet_Add(&set, &r, nextId));
+			list[listCount].rect = r;
+			list[listCount].rect.x += scroll;
+			list[listCount].id = nextId++;
+			listCount++;
+		}
+
+		i32 prevScroll = set.scroll;
+		i32 dx = xorshift32_range(&s, 1, 9);
+		ColliderSet_Scroll(&set, dx);
+		scroll += dx;
+		if(set.scroll < prevScroll) rebases++;
+		ColliderSet_Cull(&set, 0);
+
+		u32 kept = 0;
+		for(u32 i = 0; i < listCount; i++)
+		{
+			if(list[i].rect.x + list[i].rect.w - scroll >= 0) list[kept++] = list[i];
+		}
+		listCount = kept;
+
+		// the set's ring stays sorted by left edge
+		for(u32 i = 1; i < set.count; i++)
+		{
+			u32 prev = (set.head + i - 1) & (COLLIDERSET_MAX - 1);
+			u32 cur = (set.head + i) & (COLLIDERSET_MAX - 1);
+			CHECK(PackedBox_Min(set.x[prev]) <= PackedBox_Min(set.x[cur]));
+		}
+
+		Rectangle q = RandomRect(&s, 0, 160, 32);
+		u32 hits[COLLIDERSET_MAX];
+		u32 hitCount = ColliderSet_Query(&set, &q, hits, COLLIDERSET_MAX);
+
+		u32 expected = 0;
+		for(u32 i = 0; i < listCount; i++)
+		{
+			Rectangle r = list[i].rect;
+			r.x -= scroll;
+			if(!CheckCollision_RectRect(&q, &r)) continue;
+
+			expected++;
+			u32 found = 0;
+			for(u32 h = 0; h < hitCount; h++) found |= hits[h] == list[i].id;
+			CHECK(found);
+		}
+		CHECK_EQ(hitCount, expected);
+		CHECK_EQ(ColliderSet_Hit(&set, &q), hitCount ? hits[0] : COLLIDER_NONE);
+
+		// a one-hit limit stops at the first
+		if(hitCount)
+		{
+			u32 first;
+			CHECK_EQ(ColliderSet_Query(&set, &q, &first, 1), 1);
+			CHECK_EQ(first, hits[0]);
+		}
+	}
+	CHECK(rebases > 100);
+}
+
+int main(void)
+{
+	Test_Sweep1D();
+	Test_Random2D();
+	Test_OverlapMask();
+	Test_ColliderSet();
+	return TEST_END();
+}
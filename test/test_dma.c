@@ -0,0 +1,151 @@
+#include <string.h>
+
+#include "test.h"
+#include "dma.h"
+
+static u16 src16[0x4000] __attribute__((aligned(4)));
+static u16 dst16[0x4000] __attribute__((aligned(4)));
+static u32 big[0x10000];
+
+static void Fill_Pattern(void)
+{
+	for(u32 i = 0; i < sizeof(src16) / sizeof(src16[0]); i++) src16[i] = i * 0x9E37 + 1;
+	memset(dst16, 0, sizeof(dst16));
+}
+
+// immediate copies and fills: data, count and the per-channel log
+static void Test_Immediate(void)
+{
+	for(u32 ch = 0; ch < DMA_CHANNEL_COUNT; ch++)
+	{
+		DMA_HostReset();
+		Fill_Pattern();
+
+		DMA_Copy16(ch, dst16 + 1, src16, 7);
+		CHECK(memcmp(dst16 + 1, src16, 7 * 2) == 0);
+		CHECK_EQ(dst16[0], 0);
+		CHECK_EQ(dst16[8], 0);
+
+		DMA_Copy32(ch, dst16 + 16, src16, 5);
+		CHECK(memcmp(dst16 + 16, src16, 5 * 4) == 0);
+		CHECK_EQ(dst16[26], 0);
+
+		DMA_Fill16(ch, dst16 + 32, 0xBEEF, 3);
+		CHECK(dst16[32] == 0xBEEF && dst16[33] == 0xBEEF && dst16[34] == 0xBEEF);
+		CHECK_EQ(dst16[35], 0);
+
+		DMA_Fill32(ch, dst16 + 40, 0x12345678, 2);
+		CHECK(((u32 *)dst16)[20] == 0x12345678 && ((u32 *)dst16)[21] == 0x12345678);
+		CHECK_EQ(dst16[44], 0);
+
+		// only this channel did anything
+		for(u32 other = 0; other < DMA_CHANNEL_COUNT; other++)
+		{
+			const DMA_HostLog *log = &DMA_HostLogs[other];
+			if(other != ch)
+			{
+				CHECK_EQ(log->transfers, 0);
+				continue;
+			}
+			CHECK_EQ(log->transfers, 4);
+			CHECK_EQ(log->units, 7 + 5 + 3 + 2);
+			CHECK_EQ(log->bytes, 7 * 2 + 5 * 4 + 3 * 2 + 2 * 4);
+			CHECK(log->lastCnt & DMA_32);
+			CHECK_EQ(log->lastCnt & DMACNT_COUNT_MASK, 2);
+		}
+		CHECK(!DMA_Busy(ch));
+	}
+}
+
+// a count of 0 is the longest transfer the channel can do
+static void Test_ZeroCount(void)
+{
+	DMA_HostReset();
+	DMA_Fill16(0, dst16, 0x5A5A, 0);
+	CHECK_EQ(DMA_HostLogs[0].units, 0x4000);
+	CHECK(dst16[0x3FFF] == 0x5A5A);
+
+	DMA_Fill32(3, big, 0xA5A5A5A5, 0);
+	CHECK_EQ(DMA_HostLogs[3].units, 0x10000);
+	CHECK(big[0] == 0xA5A5A5A5 && big[0xFFFF] == 0xA5A5A5A5);
+}
+
+// address modes: decrementing source, fixed destination
+static void Test_AddressModes(void)
+{
+	DMA_HostReset();
+	Fill_Pattern();
+
+	DMA_Start(3, dst16, src16 + 3, 4, DMA_16 | DMA_SRC(DMA_ADDR_DEC) | DMA_DST(DMA_ADDR_INC));
+	CHECK(dst16[0] == src16[3] && dst16[1] == src16[2] && dst16[2] == src16[1] && dst16[3] == src16[0]);
+
+	DMA_Start(3, dst16 + 8, src16, 4, DMA_16 | DMA_SRC(DMA_ADDR_INC) | DMA_DST(DMA_ADDR_FIXED));
+	CHECK_EQ(dst16[8], src16[3]);
+	CHECK_EQ(dst16[9], 0);
+}
+
+// blank-timed transfers wait for their trigger. A repeating one with a
+// reloading destination writes the same place each time from the next
+// source units, and stays on until stopped
+static void Test_Timed(void)
+{
+	DMA_HostReset();
+	Fill_Pattern();
+
+	DMA_Start(0, dst16, src16, 2, DMA_HBLANK_COPY16);
+	CHECK(DMA_Busy(0));
+	CHECK_EQ(dst16[0], 0);
+
+	DMA_HostTrigger(DMA_TIMING_VBLANK);
+	CHECK_EQ(DMA_HostLogs[0].transfers, 0);
+
+	DMA_HostTrigger(DMA_TIMING_HBLANK);
+	CHECK(dst16[0] == src16[0] && dst16[1] == src16[1]);
+	DMA_HostTrigger(DMA_TIMING_HBLANK);
+	CHECK(dst16[0] == src16[2] && dst16[1] == src16[3]);
+	CHECK_EQ(dst16[2], 0);
+	CHECK(DMA_Busy(0));
+	CHECK_EQ(DMA_HostLogs[0].transfers, 2);
+
+	DMA_Stop(0);
+	CHECK(!DMA_Busy(0));
+	DMA_HostTrigger(DMA_TIMING_HBLANK);
+	CHECK_EQ(DMA_HostLogs[0].transfers, 2);
+
+	// one-shot at VBlank
+	DMA_Start(1, dst16 + 16, src16, 4, DMA_VBLANK_COPY32);
+	CHECK(DMA_Busy(1));
+	DMA_HostTrigger(DMA_TIMING_VBLANK);
+	CHECK(memcmp(dst16 + 16, src16, 4 * 4) == 0);
+	CHECK(!DMA_Busy(1));
+	DMA_HostTrigger(DMA_TIMING_VBLANK);
+	CHECK_EQ(DMA_HostLogs[1].transfers, 1);
+}
+
+// a started fill keeps its value in the channel's slot, 16-bit fills
+// take the low half
+static void Test_StartFill(void)
+{
+	DMA_HostReset();
+	memset(dst16, 0, sizeof(dst16));
+
+	DMA_StartFill(2, dst16, 0xFFFF1234, 3, DMA_16 | DMA_DST(DMA_ADDR_INC));
+	CHECK(dst16[0] == 0x1234 && dst16[2] == 0x1234);
+	CHECK_EQ(dst16[3], 0);
+	CHECK_EQ((DMA_HostLogs[2].lastCnt >> DMACNT_SRCMODE_SHIFT) & 3, DMA_ADDR_FIXED);
+
+	DMA_StartFill(2, dst16 + 8, 0xCAFEF00D, 2, DMA_32 | DMA_DST(DMA_ADDR_INC) | DMA_TIMING(DMA_TIMING_VBLANK));
+	CHECK_EQ(dst16[8], 0);
+	DMA_HostTrigger(DMA_TIMING_VBLANK);
+	CHECK(((u32 *)dst16)[4] == 0xCAFEF00D && ((u32 *)dst16)[5] == 0xCAFEF00D);
+}
+
+int main(void)
+{
+	Test_Immediate();
+	Test_ZeroCount();
+	Test_AddressModes();
+	Test_Timed();
+	Test_StartFill();
+	return TEST_END();
+}
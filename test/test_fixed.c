@@ -0,0 +1,154 @@
+#include <math.h>
+#include <stdlib.h>
+
+#include "test.h"
+#include "fixed.h"
+
+// fixed.h against double precision. The bounds are what each operation
+// promises in fixed.h: exact for the conversions and mul (truncation),
+// a unit in the last place for div by a small divisor and sqrt, and the
+// table resolution for the trig
+#define SAMPLES 1000000
+#define LSB (1.0 / FP_ONE)
+#define FP_TEST_PI 3.14159265358979323846
+
+static u32 rng = 0x2545F491;
+static u32 Next(void)
+{
+	rng ^= rng << 13;
+	rng ^= rng >> 17;
+	rng ^= rng << 5;
+	return rng;
+}
+
+static double ToDouble(fp_t v) { return v * LSB; }
+
+static void Test_Conversions(void)
+{
+	for(i32 i = -32768; i < 32768; i++)
+	{
+		CHECK_EQ(FP2Int(Int2FP(i)), i);
+		CHECK_EQ(FP82Int(Int2FP8(i & 0x7F)), i & 0x7F);
+		CHECK_EQ(FP242Int(Int2FP24(i * 256)), i * 256);
+	}
+	for(u32 n = 0; n < SAMPLES; n++)
+	{
+		fp_t v = (i32)Next();
+		CHECK_EQ(FP2Int(v), (i32)floor(ToDouble(v)));
+		CHECK_EQ(FP2IntRound(v >> 1), (i32)floor(ToDouble(v >> 1) + 0.5));
+		CHECK_EQ(FP242FP(FP2FP24(v >> 8)), (v >> 8) & ~0xFF);
+		fp8_t v8 = FP2FP8(v >> 8);
+		CHECK_EQ(FP82FP(v8), (v >> 8) & ~0xFF);
+	}
+}
+
+// the product rounded towards -inf, same as the shift
+static void Test_Mul(void)
+{
+	for(u32 n = 0; n < SAMPLES; n++)
+	{
+		fp_t a = (i32)Next() >> 12, b = (i32)Next() >> 12;
+		CHECK_EQ(fp_mul(a, b), (fp_t)floor(ToDouble(a) * ToDouble(b) * FP_ONE));
+
+		fp8_t a8 = Next(), b8 = (i32)Next() >> 20;
+		CHECK_EQ(fp8_mul(a8, b8), (fp8_t)floor(a8 / 256.0 * b8));
+
+		fp24_t a24 = (i32)Next() >> 14, b24 = (i32)Next() >> 14;
+		CHECK_EQ(fp24_mul(a24, b24), (fp24_t)floor(a24 / 256.0 * b24));
+	}
+}
+
+// truncated, so within an LSB while the divisor is under 128.0. Bigger
+// divisors are shifted down first and the error grows with the bits lost
+static void Test_Div(void)
+{
+	double worstSmall = 0, worstRel = 0;
+	for(u32 n = 0; n < SAMPLES; n++)
+	{
+		fp_t a = (i32)Next() >> (Next() & 15);
+		fp_t b = (i32)Next() >> (Next() & 31);
+		if(b == 0) continue;
+		double exact = ToDouble(a) / ToDouble(b);
+		if(fabs(exact) >= 32767.0) continue;
+
+		double got = ToDouble(fp_div(a, b));
+		double err = fabs(got - exact);
+		if(abs(b) < Int2FP(128))
+		{
+			if(err > worstSmall) worstSmall = err;
+		}
+		else if(fabs(exact) > 1.0 && err / fabs(exact) > worstRel)
+		{
+			worstRel = err / fabs(exact);
+		}
+	}
+	CHECK(worstSmall <= LSB);
+	CHECK(worstRel < 0.002);
+	printf("  div: worst %.3g LSB below 128.0, worst relative %.3g%% above\n", worstSmall / LSB, worstRel * 100);
+
+	for(u32 n = 0; n < SAMPLES; n++)
+	{
+		fp_t a = (Next() & 0x7FFFFF) + FP_ONE;
+		CHECK(fabs(ToDouble(fp_recip(a)) - 1.0 / ToDouble(a)) < LSB);
+	}
+}
+
+static void Test_Sqrt(void)
+{
+	for(u32 n = 0; n < SAMPLES; n++)
+	{
+		fp_t a = Next() & 0x7FFFFFFF;
+		double exact = sqrt(ToDouble(a));
+		CHECK(fabs(ToDouble(fp_sqrt(a)) - exact) < LSB);
+	}
+	CHECK_EQ(fp_sqrt(0), 0);
+	CHECK_EQ(fp_sqrt(-FP_ONE), 0);
+	CHECK_EQ(fp_sqrt(Int2FP(4)), Int2FP(2));
+}
+
+// every angle
+static void Test_Trig(void)
+{
+	double worst = 0;
+	for(u32 angle = 0; angle < FP_ANGLE_FULL; angle++)
+	{
+		double rad = angle * (2.0 * FP_TEST_PI / FP_ANGLE_FULL);
+		double es = fabs(ToDouble(fp_sin(angle)) - sin(rad));
+		double ec = fabs(ToDouble(fp_cos(angle)) - cos(rad));
+		if(es > worst) worst = es;
+		if(ec > worst) worst = ec;
+	}
+	CHECK(worst < 4e-4);
+	printf("  sin/cos: worst %.3g over every angle\n", worst);
+
+	// atan2 in angle units, against a grid and random points of any scale
+	u32 worstAngle = 0;
+	for(u32 n = 0; n < SAMPLES; n++)
+	{
+		i32 x, y;
+		if(n < 65536) { x = (i32)(n & 0xFF) - 128; y = (i32)(n >> 8) - 128; }
+		else          { x = (i32)Next() >> (Next() & 31); y = (i32)Next() >> (Next() & 31); }
+		if(x == 0 && y == 0) continue;
+
+		double exact = atan2((double)y, (double)x) * (FP_ANGLE_FULL / (2.0 * FP_TEST_PI));
+		if(exact < 0) exact += FP_ANGLE_FULL;
+		i32 diff = (i32)fp_atan2(y, x) - (i32)lround(exact);
+		diff = (diff + FP_ANGLE_FULL / 2) % FP_ANGLE_FULL;
+		if(diff < 0) diff += FP_ANGLE_FULL;
+		diff -= FP_ANGLE_FULL / 2;
+		if((u32)abs(diff) > worstAngle) worstAngle = abs(diff);
+	}
+	CHECK(worstAngle <= 2);
+	CHECK_EQ(fp_atan2(0, 0), 0);
+	printf("  atan2: worst %u angle units\n", worstAngle);
+}
+
+int main(void)
+{
+	Test_Conversions();
+	Test_Mul();
+	Test_Div();
+	Test_Sqrt();
+	Test_Trig();
+	return TEST_END();
+}
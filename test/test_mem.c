@@ -0,0 +1,104 @@
+#include <string.h>
+
+#include "test.h"
+#include "mem.h"
+
+// memcpy16/memcpy32/memset32 and the CpuSet wrappers against libc, for
+// every start alignment the routines allow and lengths covering the
+// 8-word blocks, the leftover words and the stray halfwords. The bytes
+// around the destination have to come out untouched
+#define BUF_BYTES 512
+#define GUARD 0xCD
+
+static u8 src[BUF_BYTES] __attribute__((aligned(4)));
+static u8 dst[BUF_BYTES] __attribute__((aligned(4)));
+static u8 ref[BUF_BYTES] __attribute__((aligned(4)));
+
+static void Reset(void)
+{
+	for(u32 i = 0; i < BUF_BYTES; i++) src[i] = i * 7 + 3;
+	memset(dst, GUARD, BUF_BYTES);
+	memset(ref, GUARD, BUF_BYTES);
+}
+
+static void Test_Memcpy16(void)
+{
+	// halfword offsets 0-3 put src and dst at every mix of word alignments
+	for(u32 d = 0; d < 4; d++) for(u32 s = 0; s < 4; s++) for(u32 n = 0; n <= 40; n++)
+	{
+		Reset();
+		memcpy16(dst + d * 2, src + s * 2, n);
+		memcpy(ref + d * 2, src + s * 2, n * 2);
+		CHECK(memcmp(dst, ref, BUF_BYTES) == 0);
+	}
+}
+
+static void Test_Memcpy32(void)
+{
+	for(u32 d = 0; d < 2; d++) for(u32 s = 0; s < 2; s++) for(u32 n = 0; n <= 40; n++)
+	{
+		Reset();
+		memcpy32(dst + d * 4, src + s * 4, n);
+		memcpy(ref + d * 4, src + s * 4, n * 4);
+		CHECK(memcmp(dst, ref, BUF_BYTES) == 0);
+	}
+}
+
+static void Test_Memset32(void)
+{
+	static const u32 fills[] = { 0, 0xFFFFFFFF, 0x12345678 };
+	for(u32 f = 0; f < sizeof(fills) / sizeof(fills[0]); f++) for(u32 d = 0; d < 2; d++) for(u32 n = 0; n <= 40; n++)
+	{
+		Reset();
+		memset32(dst + d * 4, fills[f], n);
+		for(u32 i = 0; i < n; i++) memcpy(ref + d * 4 + i * 4, &fills[f], 4);
+		CHECK(memcmp(dst, ref, BUF_BYTES) == 0);
+	}
+}
+
+static void Test_CpuSet(void)
+{
+	for(u32 n = 0; n <= 40; n++)
+	{
+		Reset();
+		CpuSet(src + 2, dst + 2, n);
+		memcpy(ref + 2, src + 2, n * 2);
+		CHECK(memcmp(dst, ref, BUF_BYTES) == 0);
+
+		Reset();
+		CpuSet(src, dst + 4, n | CPUSET_32BIT);
+		memcpy(ref + 4, src, n * 4);
+		CHECK(memcmp(dst, ref, BUF_BYTES) == 0);
+
+		Reset();
+		CpuSet(src + 2, dst + 2, n | CPUSET_FILL);
+		for(u32 i = 0; i < n; i++) memcpy(ref + 2 + i * 2, src + 2, 2);
+		CHECK(memcmp(dst, ref, BUF_BYTES) == 0);
+
+		Reset();
+		CpuSet(src, dst, n | CPUSET_FILL | CPUSET_32BIT);
+		for(u32 i = 0; i < n; i++) memcpy(ref + i * 4, src, 4);
+		CHECK(memcmp(dst, ref, BUF_BYTES) == 0);
+
+		// always words, the count rounded up to a block of 8
+		u32 words = (n + 7) & ~7;
+		Reset();
+		CpuFastSet(src, dst, n);
+		memcpy(ref, src, words * 4);
+		CHECK(memcmp(dst, ref, BUF_BYTES) == 0);
+
+		Reset();
+		CpuFastSet(src + 4, dst, n | CPUSET_FILL);
+		for(u32 i = 0; i < words; i++) memcpy(ref + i * 4, src + 4, 4);
+		CHECK(memcmp(dst, ref, BUF_BYTES) == 0);
+	}
+}
+
+int main(void)
+{
+	Test_Memcpy16();
+	Test_Memcpy32();
+	Test_Memset32();
+	Test_CpuSet();
+	return TEST_END();
+}
@@ -0,0 +1,61 @@
+#include "test.h"
+#include "game_states.h"
+
+// MAX_TILES_LEN against every obstacle Obstacle_Create can make: each
+// gap size and each center it can pick. The columns have to reach the
+// screen edges and fit in MAX_TILES_LEN between them, and some obstacle
+// has to need all of it
+static void Test_EveryGap(void)
+{
+    u32 most = 0, cases = 0;
+    for(i32 gap = OBSTACLE_GAP_MIN; gap < OBSTACLE_GAP_MAX; gap++)
+    {
+        for(i32 y = gap / 2 + OBSTACLE_GAP_MARGIN; y < SCREEN_HEIGHT - gap / 2 - OBSTACLE_GAP_MARGIN; y++)
+        {
+            i32 top, btm;
+            Obstacle_ColumnTiles(y, gap, &top, &btm);
+            CHECK(top >= 1 && btm >= 1);
+            CHECK(top * OBSTACLE_TILE_SIZE >= y - gap / 2);
+            CHECK(btm * OBSTACLE_TILE_SIZE >= SCREEN_HEIGHT - (y + gap / 2));
+            CHECK((u32)(top + btm) <= MAX_TILES_LEN);
+            if((u32)(top + btm) > most) most = top + btm;
+            cases++;
+        }
+    }
+    CHECK_EQ(most, MAX_TILES_LEN);
+    printf("  %u gaps and centers, %u tiles at most\n", cases, most);
+}
+
+// the real thing with a full set, from many seeds. every obstacle takes
+// at most MAX_TILES_LEN entries and the four fit in OBSTACLE_TILES_MAX
+static void Test_Create(void)
+{
+    static OBJPool pool;
+    static ObstacleSet set;
+    RandRing rand;
+
+    for(u32 seed = 1; seed <= 2000; seed++)
+    {
+        OBJPool_Init(&pool);
+        set = (ObstacleSet){0};
+        RandRing_Init(&rand, seed);
+
+        for(u32 n = 0; n < 64; n++)
+        {
+            u32 slot = n % OBSTACLES_MAX;
+            if(Obstacle_Active(&set, slot)) Obstacle_Clear(&set, slot, &pool);
+
+            u32 before = set.tileCount;
+            CHECK(Obstacle_Create(&set, slot, &pool, &rand));
+            CHECK(set.tileCount - before <= MAX_TILES_LEN);
+            CHECK(set.tileCount <= OBSTACLE_TILES_MAX);
+        }
+    }
+}
+
+int main(void)
+{
+    Test_EveryGap();
+    Test_Create();
+    return TEST_END();
+}
@@ -0,0 +1,143 @@
+#include <math.h>
+
+#include "test.h"
+#include "random.h"
+
+// the batch and ring paths against one xorshift32() call per value, and
+// the bounded draws for range and uniformity
+#define SEED 0x2545F491
+#define SAMPLES 1000000
+
+static void Test_Fill(void)
+{
+	xorshift32_state a = { SEED }, b = { SEED };
+	u32 buf[100];
+	for(u32 n = 0; n < 100; n++)
+	{
+		xorshift32_fill(&a, buf, n);
+		for(u32 i = 0; i < n; i++) CHECK_EQ(buf[i], xorshift32(&b));
+		CHECK_EQ(a.a, b.a);
+	}
+
+	xorwow_state c = { { 1, 2, 3, 4, 5 }, 0 }, d = c;
+	for(u32 n = 0; n < 100; n++)
+	{
+		xorwow_fill(&c, buf, n);
+		for(u32 i = 0; i < n; i++) CHECK_EQ(buf[i], xorwow(&d));
+	}
+}
+
+// reads and refills interleaved at random, including reads from an
+// empty ring, have to give the plain sequence in order
+static void Test_RandRingOrder(void)
+{
+	RandRing ring;
+	RandRing_Init(&ring, SEED);
+	xorshift32_state ref = { SEED };
+	xorshift32_state pick = { 12345 };
+
+	for(u32 n = 0; n < SAMPLES; n++)
+	{
+		u32 r = xorshift32(&pick);
+		if((r & 0xF) == 0) RandRing_Refill(&ring);
+		CHECK(ring.count <= RANDRING_LEN);
+		CHECK_EQ(RandRing_Next(&ring), xorshift32(&ref));
+	}
+
+	// Range takes one value per draw bar a redraw, same as the direct call
+	RandRing_Init(&ring, SEED);
+	ref.a = SEED;
+	for(u32 n = 0; n < SAMPLES; n++)
+	{
+		u32 r = xorshift32(&pick);
+		if((r & 0x7) == 0) RandRing_Refill(&ring);
+		u32 max = 2 + (r >> 16);
+		CHECK_EQ(RandRing_Range(&ring, 1, max), xorshift32_range(&ref, 1, max));
+	}
+}
+
+// chi-squared against the expected count per value. with this many
+// degrees of freedom the statistic is close to normal, six deviations
+// out is not going to happen by chance with a fixed seed
+static u32 counts[1024];
+
+static double ChiSquared(u32 range, u32 samples)
+{
+	double expected = (double)samples / range, chi = 0;
+	for(u32 v = 0; v < range; v++)
+	{
+		double d = counts[v] - expected;
+		chi += d * d / expected;
+	}
+	return chi;
+}
+
+static void Test_Uniform(void)
+{
+	static const u32 ranges[] = { 2, 3, 7, 10, 46, 64, 65, 100, 127, 1000, 1024 };
+	for(u32 r = 0; r < sizeof(ranges) / sizeof(ranges[0]); r++)
+	{
+		u32 range = ranges[r];
+		u32 samples = range * 1000;
+		double limit = (range - 1) + 6 * sqrt(2.0 * (range - 1));
+
+		xorshift32_state s = { SEED };
+		for(u32 v = 0; v < range; v++) counts[v] = 0;
+		for(u32 n = 0; n < samples; n++)
+		{
+			u32 v = xorshift32_range(&s, 10, 10 + range);
+			CHECK(v >= 10 && v < 10 + range);
+			counts[(v - 10) & 1023]++;
+		}
+		CHECK(ChiSquared(range, samples) < limit);
+
+		for(u32 v = 0; v < range; v++) counts[v] = 0;
+		for(u32 n = 0; n < samples; n++)
+		{
+			u32 v = xorshift32_range_pow2(&s, 10, 10 + range);
+			CHECK(v >= 10 && v < 10 + range);
+			counts[(v - 10) & 1023]++;
+		}
+		CHECK(ChiSquared(range, samples) < limit);
+	}
+
+	// the largest range still lands in it
+	xorshift32_state s = { SEED };
+	for(u32 n = 0; n < SAMPLES; n++)
+	{
+		CHECK(xorshift32_range(&s, 1, 0xFFFFFFFF) >= 1);
+		CHECK(xorshift32_range_pow2(&s, 1, 0xFFFFFFFF) >= 1);
+	}
+}
+
+// _range_pow2 is the top bits of each draw, skipping the ones past the
+// range. a range of one doesn't draw at all
+static void Test_RangePow2(void)
+{
+	xorshift32_state s = { SEED }, ref = { SEED };
+	CHECK_EQ(xorshift32_range_pow2(&s, 5, 6), 5);
+	CHECK_EQ(s.a, SEED);
+
+	for(u32 n = 0; n < SAMPLES; n++)
+	{
+		u32 range = 2 + (n % 300);
+		u32 bits = 0;
+		while((1u << bits) < range) bits++;
+
+		u32 v;
+		do {
+			v = xorshift32(&ref) >> (32 - bits);
+		} while(v >= range);
+		CHECK_EQ(xorshift32_range_pow2(&s, 0, range), v);
+	}
+	CHECK_EQ(s.a, ref.a);
+}
+
+int main(void)
+{
+	Test_Fill();
+	Test_RandRingOrder();
+	Test_Uniform();
+	Test_RangePow2();
+	return TEST_END();
+}
@@ -0,0 +1,85 @@
+#include <string.h>
+
+#include "test.h"
+#include "residency.h"
+
+// every asset starts stale, an upload makes it resident and the log
+// records it
+static void Test_Upload(void)
+{
+    Residency_Begin();
+    for(u32 id = 0; id < RESIDENCY_MAX; id++) CHECK(Residency_Stale(id));
+
+    Residency_Uploaded(2, "two", 64);
+    Residency_Uploaded(5, "five", 32);
+    for(u32 id = 0; id < RESIDENCY_MAX; id++) CHECK_EQ(Residency_Stale(id), id != 2 && id != 5);
+
+    const Residency_Log *log = Residency_GetLog();
+    CHECK_EQ(log->count, 2);
+    CHECK_EQ(log->bytes, 96);
+    CHECK(!strcmp(log->uploads[0].name, "two"));
+    CHECK_EQ(log->uploads[1].bytes, 32);
+    Residency_End();
+
+    // the next init finds both resident and logs nothing
+    Residency_Begin();
+    CHECK(!Residency_Stale(2));
+    CHECK(!Residency_Stale(5));
+    CHECK_EQ(Residency_GetLog()->count, 0);
+    CHECK_EQ(Residency_GetLog()->bytes, 0);
+    Residency_End();
+
+    for(u32 id = 0; id < RESIDENCY_MAX; id++)
+        if(Residency_Stale(id)) Residency_Uploaded(id, "rest", 0);
+}
+
+// Residency_Changed and Residency_Invalidate make only their asset
+// stale, until its next upload
+static void Test_ChangedInvalidate(void)
+{
+    for(u32 id = 0; id < RESIDENCY_MAX; id++)
+    {
+        Residency_Begin();
+        Residency_Changed(id);
+        for(u32 other = 0; other < RESIDENCY_MAX; other++) CHECK_EQ(Residency_Stale(other), other == id);
+        // changed twice, one upload still catches up
+        Residency_Changed(id);
+        CHECK(Residency_Stale(id));
+        Residency_Uploaded(id, "changed", 0);
+        CHECK(!Residency_Stale(id));
+
+        Residency_Invalidate(id);
+        for(u32 other = 0; other < RESIDENCY_MAX; other++) CHECK_EQ(Residency_Stale(other), other == id);
+        Residency_Uploaded(id, "invalidated", 0);
+        CHECK(!Residency_Stale(id));
+        Residency_End();
+    }
+}
+
+// the source generation wraps. an invalidated asset has to stay stale
+// and a changed one has to turn stale at every generation on the way
+static void Test_Wrap(void)
+{
+    const u32 id = 3;
+    for(u32 n = 0; n < 0x30000; n++)
+    {
+        Residency_Begin();
+        Residency_Changed(id);
+        CHECK(Residency_Stale(id));
+        Residency_Uploaded(id, "wrap", 0);
+        CHECK(!Residency_Stale(id));
+        Residency_Invalidate(id);
+        CHECK(Residency_Stale(id));
+        Residency_Uploaded(id, "wrap", 0);
+        CHECK(!Residency_Stale(id));
+    }
+    for(u32 other = 0; other < RESIDENCY_MAX; other++) CHECK(!Residency_Stale(other));
+}
+
+int main(void)
+{
+    Test_Upload();
+    Test_ChangedInvalidate();
+    Test_Wrap();
+    return TEST_END();
+}
@@ -0,0 +1,138 @@
+#include "test.h"
+#include "score.h"
+#include "oam.h"
+#include "bit_control.h"
+
+// The BCD counter against the digits worked out with divides, at every
+// width and with and without zero suppression. What's drawn is built up
+// only from the digits the counter marks dirty, so a missed mark shows
+// up as a stale digit
+#define ZERO_CHAR 64
+#define CHARS_PER_DIGIT 8
+
+static u32 RefDigit(u32 value, u32 n, u32 suppressZeros)
+{
+    for(u32 i = 0; i < n; i++) value /= 10;
+    if(suppressZeros && n > 0 && value == 0) return SCORE_BLANK;
+    return value % 10;
+}
+
+static void Test_Widths(void)
+{
+    for(u32 digits = 1; digits <= SCORE_DIGITS_MAX; digits++)
+    for(u32 suppress = 0; suppress < 2; suppress++)
+    {
+        Score score;
+        Score_Init(&score, digits, suppress);
+        u32 max = 1;
+        for(u32 i = 0; i < digits; i++) max *= 10;
+        max -= 1;
+
+        // up to saturation and past it for the narrow ones, 0..99999 for
+        // the rest, then the last few up to their top
+        u32 shown[SCORE_DIGITS_MAX];
+        for(u32 step = 0; step <= 100004; step++)
+        {
+            if(step == 100000 && max > 100000)
+            {
+                u32 bcd = 0;
+                for(u32 v = max - 4, i = 0; i < digits; i++, v /= 10) bcd |= (v % 10) << (i * 4);
+                score.value = max - 4;
+                score.bcd = bcd;
+                score.dirty = 0xFFFFFFFF >> ((SCORE_DIGITS_MAX - digits) * 4);
+            }
+
+            for(u32 n = 0; n < digits; n++)
+            {
+                if((score.dirty >> (n * 4)) & 0xF) shown[n] = Score_Digit(&score, n);
+            }
+            score.dirty = 0;
+
+            u32 value = score.value;
+            CHECK(value <= max);
+            for(u32 n = 0; n < digits; n++)
+            {
+                CHECK_EQ(shown[n], RefDigit(value, n, suppress));
+            }
+            CHECK_EQ(Score_Increment(&score), value < max);
+            if(value == max) CHECK_EQ(score.value, max);
+        }
+    }
+}
+
+// The OBJ path over 0..9999 as the game draws it. Each digit's attr2 is
+// checked after every point, and the digits are only touched when they
+// change: 11106 entries from 1 to 9999 on top of the first draw's 4,
+// where redrawing all four every point would touch 40000
+static void Test_DrawOBJ(void)
+{
+    static const u32 idx[4] = { 10, 11, 12, 13 };
+    Score score;
+    Score_Init(&score, 4, FALSE);
+    OAM_Init();
+    Score_DrawOBJ(&score, idx, ZERO_CHAR, CHARS_PER_DIGIT);
+
+    u32 touched = 0;
+    for(u32 value = 0; value <= 9999; value++)
+    {
+        for(u32 i = 0; i < 4; i++)
+        {
+            u32 charName = OAM_Shadow[idx[i]].attr2 & ((1 << ATTR2_CHARNAME_LEN) - 1);
+            CHECK_EQ(charName, ZERO_CHAR + CHARS_PER_DIGIT * RefDigit(value, 3 - i, FALSE));
+            CHECK(!(OAM_Shadow[idx[i]].attr0 & (1 << ATTR0_DISABLE)));
+        }
+        for(u32 w = 0; w < OAM_COUNT / 32; w++)
+        {
+            touched += __builtin_popcount(OAM_DirtyBits[w]);
+            OAM_DirtyBits[w] = 0;
+        }
+        Score_Increment(&score);
+        Score_DrawOBJ(&score, idx, ZERO_CHAR, CHARS_PER_DIGIT);
+    }
+    CHECK_EQ(touched, 4 + 9999 + 999 + 99 + 9);
+
+    // suppressed zeros switch their OBJ off until they're needed
+    Score_Init(&score, 4, TRUE);
+    Score_DrawOBJ(&score, idx, ZERO_CHAR, CHARS_PER_DIGIT);
+    for(u32 value = 0; value <= 1000; value++)
+    {
+        for(u32 i = 0; i < 4; i++)
+        {
+            u32 hidden = (OAM_Shadow[idx[i]].attr0 >> ATTR0_DISABLE) & 1;
+            CHECK_EQ(hidden, RefDigit(value, 3 - i, TRUE) == SCORE_BLANK);
+        }
+        Score_Increment(&score);
+        Score_DrawOBJ(&score, idx, ZERO_CHAR, CHARS_PER_DIGIT);
+    }
+}
+
+// the BG path puts each digit's 2x2 tiles in their cells, tile 0 when blank
+static void Test_DrawBG(void)
+{
+    static BG_TxtMode_Tile map[32 * 2];
+    Score score;
+    Score_Init(&score, 4, TRUE);
+    for(u32 value = 0; value <= 9999; value++)
+    {
+        Score_DrawBG(&score, map, 16);
+        for(u32 i = 0; i < 4; i++)
+        {
+            u32 digit = RefDigit(value, 3 - i, TRUE);
+            u32 tile = (digit == SCORE_BLANK) ? 0 : 16 + digit * 4;
+            u32 step = (digit == SCORE_BLANK) ? 0 : 1;
+            CHECK_EQ(map[i * 2], tile);
+            CHECK_EQ(map[i * 2 + 1], tile + step);
+            CHECK_EQ(map[i * 2 + 32], tile + step * 2);
+            CHECK_EQ(map[i * 2 + 33], tile + step * 3);
+        }
+        Score_Increment(&score);
+    }
+}
+
+int main(void)
+{
+    Test_Widths();
+    Test_DrawOBJ();
+    Test_DrawBG();
+    return TEST_END();
+}
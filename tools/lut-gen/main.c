@@ -0,0 +1,73 @@
+// Generates the ROM lookup tables used by source/fixed.h
+//
+//     lut-gen <output.c>
+//
+// The sizes and formats have to match the FP_*_LUT defines in fixed.h
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#define SIN_LUT_LEN 512
+#define SIN_LUT_FRACBITS 12
+
+#define ATAN_LUT_LEN 257
+// binary angle units in a full circle
+#define ANGLE_FULL 65536.0
+
+void WriteTable(FILE *out, const char *decl, const long values[], int len)
+{
+    fprintf(out, "%s = {\n\t", decl);
+    for(int i = 0; i < len; i++)
+    {
+        if(i % 12 == 0 && i != 0)
+        {
+            fprintf(out, "\n\t");
+        }
+        fprintf(out, "%6ld", values[i]);
+        if(i != len - 1)
+        {
+            fprintf(out, ",");
+        }
+    }
+    fprintf(out, "\n};\n\n");
+}
+
+int main(int argc, char *argv[])
+{
+    if(argc != 2)
+    {
+        printf("usage: %s <output.c>\n", argv[0]);
+        return 1;
+    }
+
+    FILE *out = fopen(argv[1], "w");
+    if(!out)
+    {
+        printf("Couldn't open file %s\n", argv[1]);
+        return 1;
+    }
+
+    long sinLUT[SIN_LUT_LEN];
+    for(int i = 0; i < SIN_LUT_LEN; i++)
+    {
+        sinLUT[i] = lround(sin(2.0 * M_PI * i / SIN_LUT_LEN) * (1 << SIN_LUT_FRACBITS));
+    }
+
+    long atanLUT[ATAN_LUT_LEN];
+    for(int i = 0; i < ATAN_LUT_LEN; i++)
+    {
+        atanLUT[i] = lround(atan(i / 256.0) / (2.0 * M_PI) * ANGLE_FULL);
+    }
+
+    fprintf(out, "// Generated by tools/lut-gen, don't edit by hand\n\n");
+    fprintf(out, "#include \"fixed.h\"\n\n");
+    fprintf(out, "// sin(2*pi * i / %d), 4.%d\n", SIN_LUT_LEN, SIN_LUT_FRACBITS);
+    WriteTable(out, "const i16 FP_SinLUT[FP_SIN_LUT_LEN] __attribute__((aligned(4)))", sinLUT, SIN_LUT_LEN);
+    fprintf(out, "// atan(i / 256), 0x10000 units to the circle\n");
+    WriteTable(out, "const u16 FP_AtanLUT[FP_ATAN_LUT_LEN] __attribute__((aligned(4)))", atanLUT, ATAN_LUT_LEN);
+
+    fclose(out);
+    return 0;
+}
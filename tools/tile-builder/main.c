@@ -2,6 +2,10 @@
 // and pack the pixel values into a 1D array (DISPCNT bit 6) that
 // can be read into VRAM, keeping track of the offsets and sprite
 // sizes (OAM Attr1 Obj Size)
+//
+// It also writes a 1-bit collision mask for each sprite, one 32-bit word
+// per row with the leftmost pixel in bit 31 and palette index 0 (clear)
+// as 0. Sprites wider than 32 pixels don't get one
 
 
 #include <stdio.h>
@@ -16,12 +20,19 @@
 #define TILE_WIDTH 8
 #define FILENAME_MAX_LEN 128
 
+// one row per line of every sprite that fits in VRAM
+#define MAX_MASK_ROWS (32768 / 8)
+#define MASK_MAX_WIDTH 32
+
 typedef struct
 {
     char name[128];
     uint32_t charNameIdx;
     uint8_t attr0ObjShape;
     uint8_t attr1ObjSize;
+    uint32_t width;
+    uint32_t height;
+    int32_t maskIdx; // -1 if there's no mask
 } SpriteRecord_t;
 
 typedef struct
@@ -110,7 +121,7 @@ OBJShapeSize_t GetShapeSize(uint8_t width, uint8_t height)
     return shapeSize;
 }
 
-void WriteFiles(SpriteRecord_t spriteRecords[], uint8_t compiledData[], uint32_t compiledDataLen, uint32_t bitmapsLen)
+void WriteFiles(SpriteRecord_t spriteRecords[], uint8_t compiledData[], uint32_t compiledDataLen, uint32_t masks[], uint32_t masksLen, uint32_t bitmapsLen)
 {
     FILE *outHeaderFile;
     FILE *outImplFile;
@@ -127,12 +138,21 @@ void WriteFiles(SpriteRecord_t spriteRecords[], uint8_t compiledData[], uint32_t
         fprintf(outHeaderFile, "#define SPRITE_%s_CHARNAME %d\n", spriteRecords[i].name, spriteRecords[i].charNameIdx);
         fprintf(outHeaderFile, "#define SPRITE_%s_OBJSHAPE %d\n", spriteRecords[i].name, spriteRecords[i].attr0ObjShape);
         fprintf(outHeaderFile, "#define SPRITE_%s_OBJSIZE %d\n", spriteRecords[i].name, spriteRecords[i].attr1ObjSize);
+        fprintf(outHeaderFile, "#define SPRITE_%s_WIDTH %d\n", spriteRecords[i].name, spriteRecords[i].width);
+        fprintf(outHeaderFile, "#define SPRITE_%s_HEIGHT %d\n", spriteRecords[i].name, spriteRecords[i].height);
+        if(spriteRecords[i].maskIdx >= 0)
+        {
+            fprintf(outHeaderFile, "#define SPRITE_%s_MASK (SpriteMasks + %d)\n", spriteRecords[i].name, spriteRecords[i].maskIdx);
+        }
         fprintf(outHeaderFile, "\n");
     }
     fprintf(outHeaderFile, "\n");
     fprintf(outHeaderFile, "#define SPRITETILES_LEN %d\n", compiledDataLen);
-    fprintf(outHeaderFile, "extern const unsigned char SpriteTiles[SPRITETILES_LEN] __attribute__((aligned(4))) __attribute__((visibility(\"hidden\")))");
-    fprintf(outHeaderFile, "\n\n");
+    fprintf(outHeaderFile, "extern const unsigned char SpriteTiles[SPRITETILES_LEN] __attribute__((aligned(4))) __attribute__((visibility(\"hidden\")));\n");
+    fprintf(outHeaderFile, "\n");
+    fprintf(outHeaderFile, "#define SPRITEMASKS_LEN %d\n", masksLen);
+    fprintf(outHeaderFile, "extern const unsigned int SpriteMasks[SPRITEMASKS_LEN] __attribute__((aligned(4))) __attribute__((visibility(\"hidden\")));\n");
+    fprintf(outHeaderFile, "\n");
     fprintf(outHeaderFile, "#endif");
 
 
@@ -153,6 +173,22 @@ void WriteFiles(SpriteRecord_t spriteRecords[], uint8_t compiledData[], uint32_t
             fprintf(outImplFile, ", ");
         }
     }
+    fprintf(outImplFile, "\n};\n\n");
+
+    fprintf(outImplFile, "#define SPRITEMASKS_LEN %d\n", masksLen);
+    fprintf(outImplFile, "const unsigned int SpriteMasks[SPRITEMASKS_LEN] __attribute__((aligned(4))) __attribute__((visibility(\"hidden\"))) = {\n\t");
+    for(uint32_t i = 0; i < masksLen; i++)
+    {
+        if(i % 8 == 0 && i != 0)
+        {
+            fprintf(outImplFile, "\n\t");
+        }
+        fprintf(outImplFile, "0x%.8x", masks[i]);
+        if(i != masksLen - 1)
+        {
+            fprintf(outImplFile, ", ");
+        }
+    }
     fprintf(outImplFile, "\n};");
 
     fclose(outHeaderFile);
@@ -208,6 +244,8 @@ int main(int argc, char **argv)
     uint8_t compiledData[32768]; // 32k of memory for OBJ tiles
     uint32_t compiledDataLen = 0; // used as an offset into `compiledData` for the bitmap currently being worked on
     uint32_t compiledDataCursor = 0;
+    uint32_t compiledMasks[MAX_MASK_ROWS];
+    uint32_t compiledMasksLen = 0;
     for(size_t bitmapIdx = 0; bitmapIdx < bitmapsLen; bitmapIdx++)
     {
         uint32_t bitmapWidth = bitmaps[bitmapIdx]->infoHeader.bitmapWidth;
@@ -221,6 +259,31 @@ int main(int argc, char **argv)
         OBJShapeSize_t shapeSize = GetShapeSize(bitmapWidth, bitmapHeight);
         spriteRecords[bitmapIdx].attr0ObjShape = shapeSize.shape;
         spriteRecords[bitmapIdx].attr1ObjSize = shapeSize.size;
+        spriteRecords[bitmapIdx].width = bitmapWidth;
+        spriteRecords[bitmapIdx].height = bitmapHeight;
+
+        // collision mask, a bit per opaque pixel
+        spriteRecords[bitmapIdx].maskIdx = -1;
+        if(bitmapWidth <= MASK_MAX_WIDTH)
+        {
+            spriteRecords[bitmapIdx].maskIdx = compiledMasksLen;
+            for(uint32_t y = 0; y < bitmapHeight; y++)
+            {
+                uint32_t row = 0;
+                for(uint32_t x = 0; x < bitmapWidth; x++)
+                {
+                    if(bitmaps[bitmapIdx]->pixelArray[y * bitmapWidth + x] != 0)
+                    {
+                        row |= 0x80000000u >> x;
+                    }
+                }
+                compiledMasks[compiledMasksLen++] = row;
+            }
+        }
+        else
+        {
+            printf("%s: wider than %d pixels, no collision mask\n", spriteRecords[bitmapIdx].name, MASK_MAX_WIDTH);
+        }
 
         uint32_t bitmapRowCursor = 0;
         uint8_t bitmapNumTiles = (bitmapWidth * bitmapHeight) / 64;
@@ -252,7 +315,7 @@ int main(int argc, char **argv)
     }
 
     // write the output files
-    WriteFiles(spriteRecords, compiledData, compiledDataLen, bitmapsLen);
+    WriteFiles(spriteRecords, compiledData, compiledDataLen, compiledMasks, compiledMasksLen, bitmapsLen);
 
     return 0;
 }